@@ -0,0 +1,145 @@
+/**
+ * @file bench_map_generator.c
+ * @brief Benchmarks the map generator over a sweep of floor layouts, sizes and seeds.
+ *
+ * Usage: bench_map_generator [cells_per_size] [first_seed] [output_file]
+ *
+ * For every layout and size, floors are generated until about cells_per_size cells were generated (at least
+ * MIN_MAPS_PER_SIZE floors). The results are written as JSON to the output file or to stdout. The peak
+ * resident set size is only known for the whole process, so it is written once after all cases.
+ */
+#include "../src/map/map.h"
+#include "../src/map/map_generator.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+
+    #include <psapi.h>
+#else
+    #include <sys/resource.h>
+#endif
+
+#define DEFAULT_CELLS_PER_SIZE 50000000ULL
+#define MIN_MAPS_PER_SIZE 3
+
+typedef struct {
+    int width;
+    int height;
+} bench_size_t;
+
+// the first entries are the sizes the game uses, the others catch scaling problems
+const bench_size_t bench_sizes[] = {
+        {DEFAULT_MAP_WIDTH, DEFAULT_MAP_HEIGHT},
+        {MAX_FLOOR_WIDTH, MAX_FLOOR_HEIGHT},
+        {201, 201},
+        {501, 501},
+        {1001, 1001},
+        {2001, 2001},
+};
+
+/**
+ * @brief Returns the current timestamp in nanoseconds.
+ */
+uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+/**
+ * @brief Returns the peak resident set size of the process in kilobytes, 0 if unknown.
+ */
+long bench_peak_rss_kb(void) {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return (long) (counters.PeakWorkingSetSize / 1024);
+    }
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+    #ifdef __APPLE__
+    return usage.ru_maxrss / 1024;// bytes on macOS
+    #else
+    return usage.ru_maxrss;
+    #endif
+#endif
+}
+
+/**
+ * @brief Generates floors of the given layout and size and writes one JSON result object.
+ *
+ * @param out the stream to write the result to
+ * @param layout the layout of the floors
+ * @param size the size of the floors
+ * @param cells_per_size the number of cells to generate
+ * @param first_seed the seed of the first floor, the following floors use the next seeds
+ * @return 0 on success, 1 if a floor could not be generated
+ */
+int bench_size(FILE* out, const floor_layout_t layout, const bench_size_t size, const uint64_t cells_per_size, const uint64_t first_seed) {
+    const uint64_t cells = (uint64_t) size.width * (uint64_t) size.height;
+    int maps = (int) (cells_per_size / cells);
+    if (maps < MIN_MAPS_PER_SIZE) maps = MIN_MAPS_PER_SIZE;
+
+    map_t* map = init_map(size.width, size.height);
+    if (map == NULL) return 1;
+
+    generation_timing_t timing = {0, 0, 0, 0, 0};
+    const uint64_t start = bench_now_ns();
+    for (int i = 0; i < maps; i++) {
+        if (generate_map_timed(map, NULL, first_seed + (uint64_t) i, layout, &timing) != COMMON_SUCCESS) {
+            fprintf(stderr, "Failed to generate a %d x %d %s floor with seed %llu\n", size.width, size.height, layout_generators[layout].name,
+                    (unsigned long long) (first_seed + (uint64_t) i));
+            free_map(map);
+            return 1;
+        }
+    }
+    const uint64_t elapsed = bench_now_ns() - start;
+    free_map(map);
+
+    const double seconds = (double) elapsed / 1e9;
+    fprintf(out,
+            "    {\"layout\": \"%s\", \"width\": %d, \"height\": %d, \"maps\": %d, \"total_ns\": %llu, \"maps_per_sec\": %.2f, "
+            "\"ns_per_cell\": %.3f, \"carve_ns\": %llu, \"loops_ns\": %llu, \"regions_ns\": %llu, \"exit_ns\": %llu, \"populate_ns\": %llu}",
+            layout_generators[layout].name, size.width, size.height, maps, (unsigned long long) elapsed, seconds > 0 ? maps / seconds : 0.0,
+            (double) elapsed / ((double) cells * maps), (unsigned long long) timing.carve_ns,
+            (unsigned long long) timing.loops_ns, (unsigned long long) timing.regions_ns, (unsigned long long) timing.exit_ns,
+            (unsigned long long) timing.populate_ns);
+    return 0;
+}
+
+int main(const int argc, char* argv[]) {
+    const uint64_t cells_per_size = argc > 1 ? strtoull(argv[1], NULL, 10) : DEFAULT_CELLS_PER_SIZE;
+    const uint64_t first_seed = argc > 2 ? strtoull(argv[2], NULL, 10) : 1;
+
+    FILE* out = stdout;
+    if (argc > 3) {
+        out = fopen(argv[3], "w");
+        if (out == NULL) {
+            fprintf(stderr, "Failed to open %s\n", argv[3]);
+            return 1;
+        }
+    }
+
+    int result = 0;
+    const int size_count = (int) (sizeof(bench_sizes) / sizeof(bench_sizes[0]));
+    fprintf(out, "{\n  \"benchmark\": \"map_generator\",\n  \"first_seed\": %llu,\n  \"results\": [\n",
+            (unsigned long long) first_seed);
+    for (int layout = 0; layout < MAX_LAYOUTS && result == 0; layout++) {
+        for (int i = 0; i < size_count && result == 0; i++) {
+            result = bench_size(out, (floor_layout_t) layout, bench_sizes[i], cells_per_size, first_seed);
+            const int last = layout == MAX_LAYOUTS - 1 && i == size_count - 1;
+            fprintf(out, !last && result == 0 ? ",\n" : "\n");
+        }
+    }
+    fprintf(out, "  ],\n  \"peak_rss_kb\": %ld\n}\n", bench_peak_rss_kb());
+
+    if (out != stdout) fclose(out);
+    return result;
+}
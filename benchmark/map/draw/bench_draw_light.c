@@ -0,0 +1,261 @@
+/**
+ * @file bench_draw_light.c
+ * @brief Benchmarks the field of view engines over a sweep of light radii, floor sizes and wall densities.
+ *
+ * Usage: bench_draw_light [calls_per_case] [seed] [output_file]
+ *
+ * Every engine is called calls_per_case times for every floor, size and radius, each call from another
+ * random floor tile. The results are written as JSON to the output file or to stdout.
+ */
+#include "../src/map/draw/draw_light.h"
+#include "../src/map/draw/light_map.h"
+#include "../src/map/map.h"
+#include "../src/map/map_generator.h"
+#include "../src/random/rng.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define DEFAULT_CALLS_PER_CASE 20000
+#define POSITION_COUNT 1024// the number of distinct positions the light is cast from
+
+#define OPEN_FLOOR (-1)// a floor without inner walls, the worst case for every engine
+
+typedef struct {
+    int width;
+    int height;
+} bench_size_t;
+
+// the first entry is the size the game uses, the others catch scaling problems
+const bench_size_t bench_sizes[] = {
+        {DEFAULT_MAP_WIDTH, DEFAULT_MAP_HEIGHT},
+        {201, 201},
+        {1001, 1001},
+        {2001, 2001},
+};
+
+const int bench_radii[] = {3, 8, 16, 32};
+
+// the floors from open to tight, OPEN_FLOOR or a layout
+const int bench_floors[] = {OPEN_FLOOR, LAYOUT_CAVE, LAYOUT_ROOMS, LAYOUT_MAZE};
+
+/**
+ * @brief A floor prepared for the engines.
+ */
+typedef struct {
+    map_t* map;
+    map_tile_t* revealed;// the target of draw_light_on_player
+    light_cache_t cache; // the cache of update_light
+    light_map_t* lights; // holds the single source of move_light_source
+    int source;
+    vector2d_t positions[POSITION_COUNT];
+} bench_floor_t;
+
+/**
+ * @brief A field of view engine, casts the light once from the given position.
+ */
+typedef struct {
+    const char* name;
+    void (*run)(bench_floor_t* floor, vector2d_t pos, int radius);
+} fov_engine_t;
+
+void run_draw_light_on_player(bench_floor_t* floor, const vector2d_t pos, const int radius) {
+    draw_light_on_player(floor->map->tiles, floor->revealed, floor->map->height, floor->map->width, pos, radius);
+}
+
+void run_update_light(bench_floor_t* floor, const vector2d_t pos, const int radius) {
+    // the position changes with every call, so the cached light is never reused
+    update_light(&floor->cache, floor->map, NULL, pos, radius, 0);
+}
+
+void run_move_light_source(bench_floor_t* floor, const vector2d_t pos, const int radius) {
+    if (floor->lights->sources[floor->source].radius != radius) {
+        remove_light_source(floor->lights, floor->source);
+        floor->source = add_light_source(floor->lights, floor->map, pos, radius, MAX_LIGHT_INTENSITY);
+        return;
+    }
+    move_light_source(floor->lights, floor->map, floor->source, pos);
+}
+
+const fov_engine_t fov_engines[] = {
+        {"draw_light_on_player", run_draw_light_on_player},
+        {"update_light", run_update_light},
+        {"move_light_source", run_move_light_source},
+};
+
+/**
+ * @brief Returns the current timestamp in nanoseconds.
+ */
+uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+/**
+ * @brief Counts the visited cells.
+ * @param data the counter
+ * @param x unused
+ * @param y unused
+ * @param steps unused
+ */
+void count_visited(void* data, const int x, const int y, const int steps) {
+    (void) x;
+    (void) y;
+    (void) steps;
+    (*(uint64_t*) data)++;
+}
+
+/**
+ * @brief Returns the name of the floor.
+ * @param floor OPEN_FLOOR or a layout
+ */
+const char* bench_floor_name(const int floor) {
+    return floor == OPEN_FLOOR ? "open" : layout_generators[floor].name;
+}
+
+/**
+ * @brief Generates a floor and picks the positions the light is cast from.
+ *
+ * @param bench the floor to prepare
+ * @param floor OPEN_FLOOR or a layout
+ * @param size the size of the floor
+ * @param seed the seed of the floor and the positions
+ * @return 0 on success, 1 if the floor could not be generated
+ */
+int prepare_floor(bench_floor_t* bench, const int floor, const bench_size_t size, const uint64_t seed) {
+    bench->map = init_map(size.width, size.height);
+    if (bench->map == NULL) return 1;
+    if (floor == OPEN_FLOOR) {
+        for (int y = 1; y < size.height - 1; y++) {
+            for (int x = 1; x < size.width - 1; x++) {
+                MAP_TILE(bench->map, x, y) = FLOOR;
+            }
+        }
+        mark_map_changed(bench->map);
+    } else if (generate_map(bench->map, NULL, seed, (floor_layout_t) floor) != COMMON_SUCCESS) {
+        fprintf(stderr, "Failed to generate a %d x %d %s floor with seed %llu\n", size.width, size.height, bench_floor_name(floor),
+                (unsigned long long) seed);
+        return 1;
+    }
+
+    rng_t rng;
+    init_rng(&rng, seed);
+    for (int i = 0; i < POSITION_COUNT; i++) {
+        vector2d_t pos;
+        do {
+            pos = (vector2d_t) {rng_range(&rng, size.width), rng_range(&rng, size.height)};
+        } while (MAP_TILE(bench->map, pos.dx, pos.dy) == WALL);
+        bench->positions[i] = pos;
+    }
+
+    bench->revealed = malloc((size_t) size.width * (size_t) size.height * sizeof(map_tile_t));
+    bench->lights = init_light_map(size.width, size.height);
+    if (bench->revealed == NULL || bench->lights == NULL) return 1;
+    bench->source = add_light_source(bench->lights, bench->map, bench->positions[0], 1, MAX_LIGHT_INTENSITY);
+    bench->cache = (light_cache_t) LIGHT_CACHE_EMPTY;
+    return bench->source == NO_LIGHT_SOURCE;
+}
+
+/**
+ * @brief Frees the prepared floor.
+ * @param bench the floor to free
+ */
+void free_floor(const bench_floor_t* bench) {
+    free_light_map(bench->lights);
+    free(bench->revealed);
+    free_map(bench->map);
+}
+
+/**
+ * @brief Returns the share of wall tiles of the map.
+ * @param map the map
+ */
+double wall_density(const map_t* map) {
+    uint64_t walls = 0;
+    for (int i = 0; i < map->width * map->height; i++) {
+        walls += map->tiles[i] == WALL;
+    }
+    return (double) walls / ((double) map->width * map->height);
+}
+
+/**
+ * @brief Times every engine on one floor and radius and writes one JSON result object per engine.
+ *
+ * @param out the stream to write the results to
+ * @param bench the prepared floor
+ * @param floor OPEN_FLOOR or the layout of the floor
+ * @param radius the light radius
+ * @param calls the number of calls per engine
+ * @param first whether no result was written yet
+ */
+void bench_case(FILE* out, bench_floor_t* bench, const int floor, const int radius, const int calls, const int first) {
+    // the cells visited do not depend on the engine
+    uint64_t visited = 0;
+    for (int i = 0; i < calls; i++) {
+        cast_field_of_view(bench->map->tiles, bench->map->height, bench->map->width, bench->positions[i % POSITION_COUNT], radius,
+                           count_visited, &visited);
+    }
+
+    const int engine_count = (int) (sizeof(fov_engines) / sizeof(fov_engines[0]));
+    for (int engine = 0; engine < engine_count; engine++) {
+        // one call outside of the timing, e.g. to clear the whole visible layer once
+        fov_engines[engine].run(bench, bench->positions[POSITION_COUNT - 1], radius);
+
+        const uint64_t start = bench_now_ns();
+        for (int i = 0; i < calls; i++) {
+            fov_engines[engine].run(bench, bench->positions[i % POSITION_COUNT], radius);
+        }
+        const uint64_t elapsed = bench_now_ns() - start;
+
+        fprintf(out,
+                "%s    {\"engine\": \"%s\", \"floor\": \"%s\", \"width\": %d, \"height\": %d, \"wall_density\": %.3f, "
+                "\"radius\": %d, \"calls\": %d, \"total_ns\": %llu, \"ns_per_call\": %.1f, \"cells_per_call\": %.1f, "
+                "\"ns_per_cell\": %.3f}",
+                first && engine == 0 ? "" : ",\n", fov_engines[engine].name, bench_floor_name(floor), bench->map->width,
+                bench->map->height, wall_density(bench->map), radius, calls, (unsigned long long) elapsed,
+                (double) elapsed / calls, (double) visited / calls, visited > 0 ? (double) elapsed / (double) visited : 0.0);
+    }
+}
+
+int main(const int argc, char* argv[]) {
+    const int calls = argc > 1 ? atoi(argv[1]) : DEFAULT_CALLS_PER_CASE;
+    const uint64_t seed = argc > 2 ? strtoull(argv[2], NULL, 10) : 1;
+    if (calls <= 0) {
+        fprintf(stderr, "The number of calls must be positive\n");
+        return 1;
+    }
+
+    FILE* out = stdout;
+    if (argc > 3) {
+        out = fopen(argv[3], "w");
+        if (out == NULL) {
+            fprintf(stderr, "Failed to open %s\n", argv[3]);
+            return 1;
+        }
+    }
+
+    int result = 0;
+    int first = 1;
+    const int floor_count = (int) (sizeof(bench_floors) / sizeof(bench_floors[0]));
+    const int size_count = (int) (sizeof(bench_sizes) / sizeof(bench_sizes[0]));
+    const int radius_count = (int) (sizeof(bench_radii) / sizeof(bench_radii[0]));
+    fprintf(out, "{\n  \"benchmark\": \"draw_light\",\n  \"seed\": %llu,\n  \"results\": [\n", (unsigned long long) seed);
+    for (int floor = 0; floor < floor_count && result == 0; floor++) {
+        for (int size = 0; size < size_count && result == 0; size++) {
+            bench_floor_t bench = {0};
+            result = prepare_floor(&bench, bench_floors[floor], bench_sizes[size], seed);
+            for (int radius = 0; radius < radius_count && result == 0; radius++) {
+                bench_case(out, &bench, bench_floors[floor], bench_radii[radius], calls, first);
+                first = 0;
+            }
+            free_floor(&bench);
+        }
+    }
+    fprintf(out, "\n  ]\n}\n");
+
+    if (out != stdout) fclose(out);
+    return result;
+}
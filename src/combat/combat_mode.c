@@ -60,7 +60,7 @@ ability_t* get_random_ability(const character_t* character);
  * @note This function must be called before using any other functions in this module.
  */
 int init_combat_mode() {
-    combat_mode_strings = (char**) malloc(MAX_COMBAT_MODE_STRINGS * sizeof(char*));
+    combat_mode_strings = (const char**) malloc(MAX_COMBAT_MODE_STRINGS * sizeof(char*));
     RETURN_WHEN_NULL(combat_mode_strings, -1, "Combat Mode", "Allocated memory for combat mode strings in memory pool is NULL");
 
     ability_menu_options = (char**) malloc(sizeof(char*) * MAX_ABILITY_LIMIT);
@@ -513,12 +513,6 @@ void collect_potion_menu_options(potion_t* potions[], const int count) {
 
 void shutdown_combat_mode() {
     if (combat_mode_strings != NULL) {
-        for (int i = 0; i < MAX_COMBAT_MODE_STRINGS; i++) {
-            if (combat_mode_strings[i] != NULL) {
-                free(combat_mode_strings[i]);
-                combat_mode_strings[i] = NULL;
-            }
-        }
         free(combat_mode_strings);
         combat_mode_strings = NULL;
     }
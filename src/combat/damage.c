@@ -11,7 +11,7 @@
 
 #include <stdlib.h>
 
-char** damage_type_names = NULL;
+const char** damage_type_names = NULL;
 
 int roll_dice(dice_size_t dice_size);
 
@@ -31,12 +31,6 @@ int init_damage_local(void) {
 
 void shutdown_damage_local(void) {
     if (damage_type_names != NULL) {
-        for (int i = 0; i < MAX_DAMAGE_TYPES; i++) {
-            if (damage_type_names[i] != NULL) {
-                free(damage_type_names[i]);
-                damage_type_names[i] = NULL;
-            }
-        }
         free(damage_type_names);
         damage_type_names = NULL;
     }
@@ -120,12 +114,6 @@ int roll_dice(const dice_size_t dice_size) {
 void update_damage_local(void) {
     if (damage_type_names == NULL) return;// module was not initialized
 
-    for (int i = 0; i < MAX_DAMAGE_TYPES; i++) {
-        if (damage_type_names[i] != NULL) {
-            free(damage_type_names[i]);
-        }
-    }
-
-    damage_type_names[PHYSICAL] = get_local_string("DAMAGE.TYPE.PHYSICAL");
-    damage_type_names[MAGICAL] = get_local_string("DAMAGE.TYPE.MAGICAL");
+    damage_type_names[PHYSICAL] = get_local_text_by_id(LOCAL_DAMAGE_TYPE_PHYSICAL);
+    damage_type_names[MAGICAL] = get_local_text_by_id(LOCAL_DAMAGE_TYPE_MAGICAL);
 }
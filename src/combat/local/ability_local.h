@@ -1,7 +1,7 @@
 #ifndef ABILITY_LOCAL_H
 #define ABILITY_LOCAL_H
 
-extern char** ability_names;
+extern const char** ability_names;
 
 int init_ability_local(void);
 
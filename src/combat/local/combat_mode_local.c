@@ -8,41 +8,35 @@
 
 #include <stdlib.h>
 
-char** combat_mode_strings = NULL;
+const char** combat_mode_strings = NULL;
 
 void update_combat_local(void) {
-    for (int i = 0; i < MAX_COMBAT_MODE_STRINGS; i++) {
-        if (combat_mode_strings[i] != NULL) {
-            free(combat_mode_strings[i]);
-        }
-    }
-
-    combat_mode_strings[COMBAT_MODE_TITLE] = get_local_string("COMBAT.MODE.TITLE");
-
-    combat_mode_strings[MAIN_MENU_TITLE] = get_local_string("COMBAT.MAIN.MENU.TITLE");
-    combat_mode_strings[ABILITY_MENU_TITLE] = get_local_string("COMBAT.ABILITY.MENU.TITLE");
-    combat_mode_strings[POTION_MENU_TITLE] = get_local_string("COMBAT.POTION.MENU.TITLE");
-    combat_mode_strings[MAIN_MENU_OPTION1] = get_local_string("COMBAT.USE.ABILITY");
-    combat_mode_strings[MAIN_MENU_OPTION2] = get_local_string("COMBAT.USE.POTION");
-
-    combat_mode_strings[ABILITY_FORMAT] = get_local_string("COMBAT.ABILITY.FORMAT");
-    combat_mode_strings[POTION_FORMAT] = get_local_string("POTION.FORMAT");
-    combat_mode_strings[PRESS_C_RETURN] = get_local_string("PRESS.C.RETURN");
-    combat_mode_strings[NO_MORE_POTIONS] = get_local_string("POTION.EMPTY");
-
-    combat_mode_strings[ATTACK_SUCCESS] = get_local_string("COMBAT.ATTACK.SUCCESS");
-    combat_mode_strings[ATTACK_MISS] = get_local_string("COMBAT.ATTACK.MISS");
-    combat_mode_strings[ATTACK_FAIL] = get_local_string("COMBAT.ATTACK.FAIL");
-    combat_mode_strings[POTION_USE] = get_local_string("COMBAT.POTION.USE");
-
-    combat_mode_strings[HEALTH_STR] = get_local_string("HEALTH");
-    combat_mode_strings[MANA_STR] = get_local_string("MANA");
-    combat_mode_strings[STAMINA_STR] = get_local_string("STAMINA");
-
-    combat_mode_strings[WON_COMBAT_MSG1] = get_local_string("COMBAT.WON.MESSAGE1");
-    combat_mode_strings[WON_COMBAT_MSG2] = get_local_string("COMBAT.WON.MESSAGE2");
-    combat_mode_strings[LOST_COMBAT_MSG] = get_local_string("COMBAT.LOST.MESSAGE");
-
-    combat_mode_strings[PRESS_ANY_CONTINUE] = get_local_string("PRESS.ANY.CONTINUE");
-    combat_mode_strings[PRESS_ANY_EXIT] = get_local_string("PRESS.ANY.EXIT");
+    combat_mode_strings[COMBAT_MODE_TITLE] = get_local_text_by_id(LOCAL_COMBAT_MODE_TITLE);
+
+    combat_mode_strings[MAIN_MENU_TITLE] = get_local_text_by_id(LOCAL_COMBAT_MAIN_MENU_TITLE);
+    combat_mode_strings[ABILITY_MENU_TITLE] = get_local_text_by_id(LOCAL_COMBAT_ABILITY_MENU_TITLE);
+    combat_mode_strings[POTION_MENU_TITLE] = get_local_text_by_id(LOCAL_COMBAT_POTION_MENU_TITLE);
+    combat_mode_strings[MAIN_MENU_OPTION1] = get_local_text_by_id(LOCAL_COMBAT_USE_ABILITY);
+    combat_mode_strings[MAIN_MENU_OPTION2] = get_local_text_by_id(LOCAL_COMBAT_USE_POTION);
+
+    combat_mode_strings[ABILITY_FORMAT] = get_local_text_by_id(LOCAL_COMBAT_ABILITY_FORMAT);
+    combat_mode_strings[POTION_FORMAT] = get_local_text_by_id(LOCAL_POTION_FORMAT);
+    combat_mode_strings[PRESS_C_RETURN] = get_local_text_by_id(LOCAL_PRESS_C_RETURN);
+    combat_mode_strings[NO_MORE_POTIONS] = get_local_text_by_id(LOCAL_POTION_EMPTY);
+
+    combat_mode_strings[ATTACK_SUCCESS] = get_local_text_by_id(LOCAL_COMBAT_ATTACK_SUCCESS);
+    combat_mode_strings[ATTACK_MISS] = get_local_text_by_id(LOCAL_COMBAT_ATTACK_MISS);
+    combat_mode_strings[ATTACK_FAIL] = get_local_text_by_id(LOCAL_COMBAT_ATTACK_FAIL);
+    combat_mode_strings[POTION_USE] = get_local_text_by_id(LOCAL_COMBAT_POTION_USE);
+
+    combat_mode_strings[HEALTH_STR] = get_local_text_by_id(LOCAL_HEALTH);
+    combat_mode_strings[MANA_STR] = get_local_text_by_id(LOCAL_MANA);
+    combat_mode_strings[STAMINA_STR] = get_local_text_by_id(LOCAL_STAMINA);
+
+    combat_mode_strings[WON_COMBAT_MSG1] = get_local_text_by_id(LOCAL_COMBAT_WON_MESSAGE1);
+    combat_mode_strings[WON_COMBAT_MSG2] = get_local_text_by_id(LOCAL_COMBAT_WON_MESSAGE2);
+    combat_mode_strings[LOST_COMBAT_MSG] = get_local_text_by_id(LOCAL_COMBAT_LOST_MESSAGE);
+
+    combat_mode_strings[PRESS_ANY_CONTINUE] = get_local_text_by_id(LOCAL_PRESS_ANY_CONTINUE);
+    combat_mode_strings[PRESS_ANY_EXIT] = get_local_text_by_id(LOCAL_PRESS_ANY_EXIT);
 }
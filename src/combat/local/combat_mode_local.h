@@ -36,7 +36,7 @@ enum combat_mode_index {
 };
 
 
-extern char** combat_mode_strings;
+extern const char** combat_mode_strings;
 
 /**
  * @brief Updates the combat mode strings with localized versions.
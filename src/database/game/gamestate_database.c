@@ -208,33 +208,61 @@ char* get_iso8601_time() {
 }
 
 char* arr2D_to_flat_json(const int* arr, const int width, const int height) {
-    const size_t buffer_size = width * height * 12 + 2;// 16 is a safe estimate for int size + comma + space
+    const size_t total_elements = (size_t) width * (size_t) height;
+    const size_t buffer_size = total_elements * 12 + 3;// 12 is a safe estimate for int size + comma
     char* json = malloc(buffer_size);
     if (json == NULL) {
         log_msg(ERROR, "GameState", "Failed to allocate memory for JSON string");
         return NULL;
     }
 
-    strcpy(json, "[");
+    // keep track of the end of the string, so appending stays linear for large maps
+    size_t length = 0;
+    json[length++] = '[';
 
-    const int total_elements = width * height;
     // Loop over the 2D map and append each element in a 1D fashion
-    for (int i = 0; i < total_elements; i++) {
-        char number[10];// Buffer to hold the number as a string
-        // Write the value into the buffer
-        snprintf(number, sizeof(number), "%d", arr[i]);
-        strcat(json, number);// Append the number to the JSON string
+    for (size_t i = 0; i < total_elements; i++) {
+        // Write the value directly at the end of the string
+        length += snprintf(json + length, buffer_size - length, "%d", arr[i]);
 
         // If it's not the last element, append a comma
         if (i < total_elements - 1) {
-            strcat(json, ",");
+            json[length++] = ',';
         }
     }
 
-    strcat(json, "]");//strcat always ensures that the string is null-terminated
+    json[length++] = ']';
+    json[length] = '\0';
     return json;
 }
 
+int get_map_dimensions_by_id(const db_connection_t* db_connection, const int game_state_id, int* width, int* height) {
+    sqlite3_stmt* stmt;
+    int rc = sqlite3_prepare_v2(db_connection->db, SQL_SELECT_MAP_STATE, -1, &stmt, NULL);
+    if (rc != SQLITE_OK) {
+        log_msg(ERROR, "GameState", "Failed to prepare statement: %s", sqlite3_errmsg(db_connection->db));
+        return 0;
+    }
+    // Bind the game state ID to the statement
+    rc = sqlite3_bind_int64(stmt, 1, game_state_id);
+    if (rc != SQLITE_OK) {
+        log_msg(ERROR, "GameState", "Failed to bind game state ID: %s", sqlite3_errmsg(db_connection->db));
+        sqlite3_finalize(stmt);
+        return 0;
+    }
+    // Execute the statement
+    rc = sqlite3_step(stmt);
+    if (rc != SQLITE_ROW) {
+        log_msg(ERROR, "GameState", "Failed to execute statement: %s", sqlite3_errmsg(db_connection->db));
+        sqlite3_finalize(stmt);
+        return 0;
+    }
+    *height = sqlite3_column_int(stmt, 0);
+    *width = sqlite3_column_int(stmt, 1);
+    sqlite3_finalize(stmt);
+    return 1;
+}
+
 int get_game_state(const db_connection_t* db_connection, int* map, int* revealed_map, const int width, const int height, int* floor, const player_pos_setter_t setter) {
     return get_game_state_by_id(db_connection, get_latest_save_id(db_connection), map, revealed_map, width, height, floor, setter);
 }
@@ -261,6 +289,14 @@ int get_game_state_by_id(const db_connection_t* db_connection, const int game_st
         sqlite3_finalize(stmt_map);
         return 0;
     }
+    // The given buffers must match the size of the stored map
+    const int stored_height = sqlite3_column_int(stmt_map, 0);
+    const int stored_width = sqlite3_column_int(stmt_map, 1);
+    if (stored_height != height || stored_width != width) {
+        log_msg(ERROR, "GameState", "Stored map has size %d x %d, expected %d x %d", stored_width, stored_height, width, height);
+        sqlite3_finalize(stmt_map);
+        return 0;
+    }
 
     sqlite3_finalize(stmt_map);
 
@@ -72,6 +72,16 @@ void create_tables_game_state(const db_connection_t* db_connection);
  * @return 0 on success none 0 on failure.
  */
 sqlite_int64 save_game_state(const db_connection_t* db_connection, const int* map, const int* revealed_map, int width, int height, int floor, vector2d_t player, const char* save_name);
+/**
+ * @brief Get the dimensions of the map stored for a specific game state.
+ *
+ * @param db_connection A database connection.
+ * @param game_state_id The id of the game state.
+ * @param width Pointer to store the width of the map.
+ * @param height Pointer to store the height of the map.
+ * @return 1 on success, 0 on failure.
+ */
+int get_map_dimensions_by_id(const db_connection_t* db_connection, int game_state_id, int* width, int* height);
 /**
  * @brief  Load the game state from the database. 
  *
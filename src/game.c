@@ -16,11 +16,12 @@
 #include "io/output/common/output_handler.h"
 #include "io/output/common/text_output.h"
 #include "logging/logger.h"
+#include "map/floor_pipeline.h"
 #include "map/map.h"
-#include "map/map_generator.h"
 #include "map/map_mode.h"
 #include "menu/main_menu.h"
 #include "menu/save_menu.h"
+#include "random/rng.h"
 #include "src/common.h"
 #include "stats/stats_mode.h"
 
@@ -32,6 +33,7 @@ db_connection_t db_connection;
 bool game_in_progress;
 game_state_t current_state;
 int exit_code;
+uint64_t game_seed;// every floor of the current game is derived from this seed
 
 /**
  * @brief The main game loop of the application.
@@ -78,10 +80,23 @@ void game_loop() {
                 main_menu_state();
                 break;
 
-            case GENERATE_MAP:
-                generate_map();
+            case GENERATE_MAP: {
+                // the first floor of a game must not continue at the exit of an earlier game
+                const map_t* previous_floor = current_floor > 1 ? current_map : NULL;
+                // usually already generated in the background, so this is only a pointer swap
+                map_t* next_floor = take_floor(previous_floor, current_floor, derive_seed(game_seed, (uint64_t) current_floor));
+                if (next_floor == NULL) {
+                    log_msg(ERROR, "Game", "Failed to generate the map for floor %d", current_floor);
+                    current_state = EXIT;
+                    break;
+                }
+                release_floor(current_map);
+                current_map = next_floor;
+                set_player_start_pos(current_map->start.dx, current_map->start.dy);
+                prepare_next_floor(current_map, current_floor + 1, derive_seed(game_seed, (uint64_t) current_floor + 1));
                 current_state = MAP_MODE;
                 break;
+            }
 
             case MAP_MODE:
                 map_mode_state();
@@ -122,6 +137,7 @@ void main_menu_state() {
                 init_player(player_name);
                 game_in_progress = true;// Mark that a game is now in progress
                 current_floor = 1;
+                game_seed = generate_seed();
                 clear_screen();
                 current_state = GENERATE_MAP;
             } else {
@@ -142,9 +158,17 @@ void main_menu_state() {
                 save_name = get_player_name();
             }
 
-            // Save the game with the provided name
-            const sqlite_int64 game_state_id = save_game_state(&db_connection, map, revealed_map, WIDTH, HEIGHT, current_floor, get_player_pos(), save_name);
-            save_character(&db_connection, *player, game_state_id);
+            // Save the game with the provided name, saves store one tile per cell column by column
+            map_tile_t* tiles = export_save_tiles(current_map);
+            map_tile_t* revealed = export_revealed_tiles(current_map);
+            if (tiles != NULL && revealed != NULL) {
+                const sqlite_int64 game_state_id = save_game_state(&db_connection, (const int*) tiles, (const int*) revealed, current_map->width, current_map->height, current_floor, get_player_pos(), save_name);
+                save_character(&db_connection, *player, game_state_id);
+            } else {
+                log_msg(ERROR, "Game", "Failed to export the tiles for the save");
+            }
+            free(tiles);
+            free(revealed);
 
             clear_screen();
             current_state = MAP_MODE;
@@ -281,8 +305,30 @@ void stats_mode_state() {
 int loading_game(const int game_state_id, const player_pos_setter_t setter) {
     if (reset_player() != 0) return 1;
     int* return_floor = &current_floor;
-    if (get_game_state_by_id(&db_connection, game_state_id, map, revealed_map, WIDTH, HEIGHT, return_floor, setter) != 1) return 2;
+    int width;
+    int height;
+    if (get_map_dimensions_by_id(&db_connection, game_state_id, &width, &height) != 1) return 2;
+    if (resize_current_map(width, height) != COMMON_SUCCESS) return 2;
+    // saves store one tile per cell column by column, see SAVE_TILE_INDEX
+    map_tile_t* tiles = malloc((size_t) width * (size_t) height * sizeof(map_tile_t));
+    map_tile_t* revealed = malloc((size_t) width * (size_t) height * sizeof(map_tile_t));
+    if (tiles == NULL || revealed == NULL || get_game_state_by_id(&db_connection, game_state_id, (int*) tiles, (int*) revealed, width, height, return_floor, setter) != 1) {
+        free(tiles);
+        free(revealed);
+        return 2;
+    }
+    import_save_tiles(current_map, tiles);
+    import_revealed_tiles(current_map, revealed);
+    free(tiles);
+    free(revealed);
+    // the player position was set while loading, its tile is always revealed
+    MAP_REVEAL(current_map, get_player_pos().dx, get_player_pos().dy);
     current_floor = *return_floor;
+    mark_map_changed(current_map);
+    locate_exit(current_map);
+    // only the tiles are stored, so the following floors get a new seed
+    game_seed = generate_seed();
+    prepare_next_floor(current_map, current_floor + 1, derive_seed(game_seed, (uint64_t) current_floor + 1));
     reset_goblin();
     get_character_from_db(&db_connection, player, game_state_id);
     if (player == NULL) return 3;
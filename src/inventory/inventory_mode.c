@@ -53,7 +53,7 @@ char** inventory_equipment_options = NULL;
 char** inventory_potion_options = NULL;
 
 int init_inventory_mode() {
-    inventory_mode_strings = (char**) malloc(sizeof(char*) * MAX_INVENTORY_STRINGS);
+    inventory_mode_strings = (const char**) malloc(sizeof(char*) * MAX_INVENTORY_STRINGS);
     RETURN_WHEN_NULL(inventory_mode_strings, -1, "Inventory Mode", "Failed to allocate memory for inventory mode strings");
 
     inventory_equipment_options = (char**) malloc(sizeof(char*) * MAX_SLOT);
@@ -596,11 +596,6 @@ void collect_inv_potion_options(potion_t* potion_inventory[], int count) {
 void shutdown_inventory_mode(void) {
     // free the local strings
     if (inventory_mode_strings != NULL) {
-        for (int i = 0; i < MAX_INVENTORY_STRINGS; i++) {
-            if (inventory_mode_strings[i] != NULL) {
-                free(inventory_mode_strings[i]);
-            }
-        }
         free(inventory_mode_strings);
     }
     // free the inventory gear options
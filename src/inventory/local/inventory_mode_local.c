@@ -8,54 +8,48 @@
 
 #include <stdlib.h>
 
-char** inventory_mode_strings = NULL;
+const char** inventory_mode_strings = NULL;
 
 void update_inventory_local(void) {
-    for (int i = 0; i < MAX_INVENTORY_STRINGS; i++) {
-        if (inventory_mode_strings[i] != NULL) {
-            free(inventory_mode_strings[i]);
-        }
-    }
-
-    inventory_mode_strings[MAIN_MENU_TITLE] = get_local_string("INVENTORY.MAIN.MENU.TITLE");
-    inventory_mode_strings[SHOW_GEAR] = get_local_string("INVENTORY.OPTION.SHOW.GEAR");
-    inventory_mode_strings[SHOW_EQUIPPED_GEAR] = get_local_string("INVENTORY.OPTION.SHOW.GEAR.EQUIPPED");
-    inventory_mode_strings[SHOW_POTIONS] = get_local_string("INVENTORY.OPTION.SHOW.POTIONS");
-
-    inventory_mode_strings[HEALTH_STR] = get_local_string("HEALTH");
-    inventory_mode_strings[MANA_STR] = get_local_string("MANA");
-    inventory_mode_strings[STAMINA_STR] = get_local_string("STAMINA");
-
-    inventory_mode_strings[INVENTORY_FULL_MSG] = get_local_string("INVENTORY.FULL");
-    inventory_mode_strings[INVENTORY_EMPTY_MSG] = get_local_string("INVENTORY.EMPTY");
-    inventory_mode_strings[INVENTORY_MENU_TITLE] = get_local_string("INVENTORY.MENU.TITLE");
-    inventory_mode_strings[INVENTORY_MENU_HEADER] = get_local_string("INVENTORY.MENU.HEADER");
-    inventory_mode_strings[INVENTORY_DROP_GEAR_MSG] = get_local_string("INVENTORY.DROP_GEAR");
-    inventory_mode_strings[INVENTORY_GEAR_FORMAT] = get_local_string("INVENTORY.GEAR.FORMAT");
-    inventory_mode_strings[INVENTORY_GEAR_FORMAT_EMPTY] = get_local_string("INVENTORY.GEAR.FORMAT.EMPTY");
-
-    inventory_mode_strings[EQUIPMENT_MENU_TITLE] = get_local_string("EQUIPMENT.MENU.TITLE");
-    inventory_mode_strings[EQUIPMENT_MENU_HEADER] = get_local_string("EQUIPMENT.MENU.HEADER");
-    inventory_mode_strings[EQUIPMENT_SLOT_FULL] = get_local_string("EQUIPMENT.SLOT.FULL");
-    inventory_mode_strings[EQUIPMENT_HANDS_SLOT_FULL] = get_local_string("EQUIPMENT.HANDS.SLOT.FULL");
-
-    inventory_mode_strings[POTION_FORMAT] = get_local_string("POTION.FORMAT");
-    inventory_mode_strings[POTION_MENU_TITLE] = get_local_string("POTION.MENU.TITLE");
-    inventory_mode_strings[POTION_MENU_HEADER] = get_local_string("POTION.MENU.HEADER");
-    inventory_mode_strings[POTION_FULL_MSG] = get_local_string("POTION.FULL");
-    inventory_mode_strings[POTION_EMPTY_MSG] = get_local_string("POTION.EMPTY");
-    inventory_mode_strings[POTION_DROP_POTION_MSG] = get_local_string("POTION.DROP_POTION");
-    inventory_mode_strings[POTION_USE] = get_local_string("COMBAT.POTION.USE");
-
-    inventory_mode_strings[LOOT_MAIN_MENU_TITLE] = get_local_string("LOOT.MAIN.MENU.TITLE");
-    inventory_mode_strings[LOOT_OPTION_SHOW_GEAR] = get_local_string("LOOT.OPTION.SHOW.GEAR");
-    inventory_mode_strings[LOOT_OPTION_SHOW_GEAR_EQUIPPED] = get_local_string("LOOT.OPTION.SHOW.GEAR.EQUIPPED");
-    inventory_mode_strings[LOOT_OPTION_SHOW_POTIONS] = get_local_string("LOOT.OPTION.SHOW.POTIONS");
-    inventory_mode_strings[LOOT_GEAR_MENU_HEADER] = get_local_string("LOOT.GEAR.MENU.HEADER");
-    inventory_mode_strings[LOOT_EQUIPMENT_MENU_HEADER] = get_local_string("LOOT.EQUIPMENT.MENU.HEADER");
-    inventory_mode_strings[LOOT_POTION_MENU_HEADER] = get_local_string("LOOT.POTION.MENU.HEADER");
-    inventory_mode_strings[FINISH_LOOTING_MSG] = get_local_string("LOOT.FINISH");
-
-    inventory_mode_strings[PRESS_C_RETURN] = get_local_string("PRESS.C.RETURN");
-    inventory_mode_strings[PRESS_ANY_CONTINUE] = get_local_string("PRESS.ANY.CONTINUE");
+    inventory_mode_strings[MAIN_MENU_TITLE] = get_local_text_by_id(LOCAL_INVENTORY_MAIN_MENU_TITLE);
+    inventory_mode_strings[SHOW_GEAR] = get_local_text_by_id(LOCAL_INVENTORY_OPTION_SHOW_GEAR);
+    inventory_mode_strings[SHOW_EQUIPPED_GEAR] = get_local_text_by_id(LOCAL_INVENTORY_OPTION_SHOW_GEAR_EQUIPPED);
+    inventory_mode_strings[SHOW_POTIONS] = get_local_text_by_id(LOCAL_INVENTORY_OPTION_SHOW_POTIONS);
+
+    inventory_mode_strings[HEALTH_STR] = get_local_text_by_id(LOCAL_HEALTH);
+    inventory_mode_strings[MANA_STR] = get_local_text_by_id(LOCAL_MANA);
+    inventory_mode_strings[STAMINA_STR] = get_local_text_by_id(LOCAL_STAMINA);
+
+    inventory_mode_strings[INVENTORY_FULL_MSG] = get_local_text_by_id(LOCAL_INVENTORY_FULL);
+    inventory_mode_strings[INVENTORY_EMPTY_MSG] = get_local_text_by_id(LOCAL_INVENTORY_EMPTY);
+    inventory_mode_strings[INVENTORY_MENU_TITLE] = get_local_text_by_id(LOCAL_INVENTORY_MENU_TITLE);
+    inventory_mode_strings[INVENTORY_MENU_HEADER] = get_local_text_by_id(LOCAL_INVENTORY_MENU_HEADER);
+    inventory_mode_strings[INVENTORY_DROP_GEAR_MSG] = get_local_text_by_id(LOCAL_INVENTORY_DROP_GEAR);
+    inventory_mode_strings[INVENTORY_GEAR_FORMAT] = get_local_text_by_id(LOCAL_INVENTORY_GEAR_FORMAT);
+    inventory_mode_strings[INVENTORY_GEAR_FORMAT_EMPTY] = get_local_text_by_id(LOCAL_INVENTORY_GEAR_FORMAT_EMPTY);
+
+    inventory_mode_strings[EQUIPMENT_MENU_TITLE] = get_local_text_by_id(LOCAL_EQUIPMENT_MENU_TITLE);
+    inventory_mode_strings[EQUIPMENT_MENU_HEADER] = get_local_text_by_id(LOCAL_EQUIPMENT_MENU_HEADER);
+    inventory_mode_strings[EQUIPMENT_SLOT_FULL] = get_local_text_by_id(LOCAL_EQUIPMENT_SLOT_FULL);
+    inventory_mode_strings[EQUIPMENT_HANDS_SLOT_FULL] = get_local_text_by_id(LOCAL_EQUIPMENT_HANDS_SLOT_FULL);
+
+    inventory_mode_strings[POTION_FORMAT] = get_local_text_by_id(LOCAL_POTION_FORMAT);
+    inventory_mode_strings[POTION_MENU_TITLE] = get_local_text_by_id(LOCAL_POTION_MENU_TITLE);
+    inventory_mode_strings[POTION_MENU_HEADER] = get_local_text_by_id(LOCAL_POTION_MENU_HEADER);
+    inventory_mode_strings[POTION_FULL_MSG] = get_local_text_by_id(LOCAL_POTION_FULL);
+    inventory_mode_strings[POTION_EMPTY_MSG] = get_local_text_by_id(LOCAL_POTION_EMPTY);
+    inventory_mode_strings[POTION_DROP_POTION_MSG] = get_local_text_by_id(LOCAL_POTION_DROP_POTION);
+    inventory_mode_strings[POTION_USE] = get_local_text_by_id(LOCAL_COMBAT_POTION_USE);
+
+    inventory_mode_strings[LOOT_MAIN_MENU_TITLE] = get_local_text_by_id(LOCAL_LOOT_MAIN_MENU_TITLE);
+    inventory_mode_strings[LOOT_OPTION_SHOW_GEAR] = get_local_text_by_id(LOCAL_LOOT_OPTION_SHOW_GEAR);
+    inventory_mode_strings[LOOT_OPTION_SHOW_GEAR_EQUIPPED] = get_local_text_by_id(LOCAL_LOOT_OPTION_SHOW_GEAR_EQUIPPED);
+    inventory_mode_strings[LOOT_OPTION_SHOW_POTIONS] = get_local_text_by_id(LOCAL_LOOT_OPTION_SHOW_POTIONS);
+    inventory_mode_strings[LOOT_GEAR_MENU_HEADER] = get_local_text_by_id(LOCAL_LOOT_GEAR_MENU_HEADER);
+    inventory_mode_strings[LOOT_EQUIPMENT_MENU_HEADER] = get_local_text_by_id(LOCAL_LOOT_EQUIPMENT_MENU_HEADER);
+    inventory_mode_strings[LOOT_POTION_MENU_HEADER] = get_local_text_by_id(LOCAL_LOOT_POTION_MENU_HEADER);
+    inventory_mode_strings[FINISH_LOOTING_MSG] = get_local_text_by_id(LOCAL_LOOT_FINISH);
+
+    inventory_mode_strings[PRESS_C_RETURN] = get_local_text_by_id(LOCAL_PRESS_C_RETURN);
+    inventory_mode_strings[PRESS_ANY_CONTINUE] = get_local_text_by_id(LOCAL_PRESS_ANY_CONTINUE);
 }
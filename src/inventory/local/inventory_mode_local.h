@@ -50,7 +50,7 @@ enum inventory_mode_index {
     MAX_INVENTORY_STRINGS
 };
 
-extern char** inventory_mode_strings;
+extern const char** inventory_mode_strings;
 
 /**
  * @brief Updates the inventory mode strings with the actual local strings.
@@ -179,6 +179,51 @@ bool get_input_blocking(input_event_t* event) {
     }
 }
 
+bool get_input_timeout(input_event_t* event, const int timeout_ms) {
+    if (!event || !gio || !gio->nc) {
+        log_msg(ERROR, "input_handler", "Null event pointer or uninitialized handler");
+        return false;
+    }
+
+    ncinput raw_input;
+    memset(&raw_input, 0, sizeof(ncinput));
+
+    // Set default values in case we return early
+    event->type = INPUT_NONE;
+    memset(&event->raw_input, 0, sizeof(ncinput));
+
+    // notcurses expects an absolute deadline on the monotonic clock
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    const int timeout = timeout_ms > 0 ? timeout_ms : 0;
+    deadline.tv_sec += timeout / 1000;
+    deadline.tv_nsec += (long) (timeout % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    // Loop until we get a valid input, the deadline passed or notcurses returns an error
+    while (true) {
+        uint32_t ret = notcurses_get(gio->nc, &deadline, &raw_input);
+        if (ret == 0 || ret == (uint32_t) -1) {
+            // Timeout or error
+            return false;
+        }
+
+        // Debounce - if we're getting keys too fast, ignore some
+        if (!should_process_key()) {
+            continue;
+        }
+
+        // Translate and fill the event structure
+        event->type = translate_input(&raw_input);
+        event->raw_input = raw_input;
+
+        return true;
+    }
+}
+
 bool get_input_nonblocking(input_event_t* event) {
     if (!event || !gio || !gio->nc) {
         log_msg(ERROR, "input_handler", "Null event pointer or uninitialized handler");
@@ -9,6 +9,9 @@
 
 #include <notcurses/notcurses.h>
 
+// how long a waiting mode sleeps at most before it checks its state again (milliseconds)
+#define INPUT_IDLE_TIMEOUT_MS 500
+
 /**
  * @brief Initialize the input handler
  * 
@@ -42,6 +45,19 @@ bool get_input_blocking(input_event_t* event);
  */
 bool get_input_nonblocking(input_event_t* event);
 
+/**
+ * @brief Get the next input event, waiting at most the given time
+ *
+ * Sleeps until an input event arrives or the timeout passed, so a mode that waits for the
+ * player uses no CPU in the meantime. The timeout is the longest time the caller can wait
+ * before it has to update its state again (e.g. for a timer).
+ *
+ * @param[out] event Pointer to an input_event_t structure to fill with the input event
+ * @param timeout_ms The maximum time to wait in milliseconds
+ * @return true if an event was retrieved, false on a timeout or error
+ */
+bool get_input_timeout(input_event_t* event, int timeout_ms);
+
 /**
  * @brief Translate a raw Notcurses input to a logical input type
  *
@@ -23,6 +23,9 @@
 // Using the global variables from io_handler.h
 // No need to redeclare them here as they're already included through io_handler.h
 
+// changes whenever the content of the standard plane is thrown away
+uint64_t screen_generation = 0;
+
 bool init_output_handler() {
     if (!gio || !gio->nc) {
         log_msg(ERROR, "output_handler", "Null Notcurses instance provided");
@@ -66,6 +69,7 @@ void clear_standard_plane(void) {
     // Clear the plane with the default colors
     ncplane_set_base(gio->stdplane, " ", 0, DEFAULT_COLORS);
     ncplane_erase(gio->stdplane);
+    screen_generation++;
 }
 
 void clear_specific_plane(struct ncplane* plane) {
@@ -76,6 +80,11 @@ void clear_specific_plane(struct ncplane* plane) {
 
     // Clear the specific plane
     ncplane_erase(plane);
+    if (plane == gio->stdplane) screen_generation++;
+}
+
+uint64_t get_screen_generation(void) {
+    return screen_generation;
 }
 
 bool handle_screen_resize(void) {
@@ -99,6 +108,7 @@ bool handle_screen_resize(void) {
         log_msg(ERROR, "output_handler", "Failed to get standard plane after resize");
         return false;
     }
+    screen_generation++;
 
     log_msg(DEBUG, "output_handler", "Screen resize handled successfully using notcurses_refresh");
     return true;
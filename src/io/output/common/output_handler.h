@@ -7,6 +7,7 @@
 
 #include <notcurses/notcurses.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 /**
  * @brief Initialize the output handler
@@ -47,6 +48,16 @@ void clear_standard_plane(void);
  */
 void clear_specific_plane(struct ncplane* plane);
 
+/**
+ * @brief Get the generation of the standard plane
+ *
+ * The generation changes whenever the standard plane is cleared or resized, so a mode that only
+ * draws its changes knows when it has to draw everything again.
+ *
+ * @return the current generation
+ */
+uint64_t get_screen_generation(void);
+
 /**
  * @brief Handle screen resize event
  *
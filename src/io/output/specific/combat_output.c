@@ -109,10 +109,8 @@ void draw_death_screen(void) {
     // Clear the screen
     clear_screen();
 
-    char* death_text = get_local_string("GAME.DEATH.MESSAGE");
     char welcome_msg[256];
-    snprintf(welcome_msg, sizeof(welcome_msg), "%s", death_text);
-    free(death_text);
+    snprintf(welcome_msg, sizeof(welcome_msg), "%s", get_local_text_by_id(LOCAL_GAME_DEATH_MESSAGE));
 
     int msg_len = strlen(welcome_msg);
     int msg_x = (width - msg_len) / 2;
@@ -15,89 +15,406 @@
 #include "../src/map/local/map_mode_local.h"
 #include "../src/map/map_mode.h"
 
+#include <stdlib.h>
+#include <string.h>
 
-void draw_map_mode(const map_tile_t* arr, const int height, const int width, const vector2d_t anchor,
-                   const vector2d_t player_pos) {
-    NULL_PTR_HANDLER_RETURN(arr, , "Draw Map Mode", "In draw_map_mode given array is NULL");
+#define PLAYER_CELL 0xff// the shadow value of the player on the entity plane
+#define NO_ENTITY 0      // the shadow value of an empty cell of the entity plane
+#define NOT_DRAWN 0xfe   // the shadow value of a cell that was not drawn yet
+#define PLAYER_INFO_WIDTH 32// the changing info lines are padded, so a shorter line covers a longer one
+#define PLAYER_INFO_HEIGHT 8// the lines below the map, including the empty line (see draw_player_info)
+
+/**
+ * @brief What was drawn of the map in the last frame.
+ *
+ * Only the window of the map around the camera is drawn. The map is drawn onto two planes above
+ * the standard plane: the terrain plane holds the tiles that do not move, the entity plane holds
+ * the player, the monsters and the items and is transparent everywhere else. notcurses composes
+ * both, so a step of the player only touches two cells of the entity plane.
+ *
+ * Only cells whose shadow differs from the map are drawn again. As long as the tiles do not
+ * change, only a newly seen tile or the player can change a cell, so the seen bits of the window
+ * are compared word by word and only the changed bits are looked at.
+ */
+typedef struct {
+    const map_t* map;// the drawn map, NULL if nothing was drawn yet
+    uint64_t version;// the version of the drawn map
+    int width;
+    int height;
+    vector2d_t anchor;
+    map_window_t window;       // the drawn part of the map
+    vector2d_t player;
+    int floor;                 // the drawn floor number
+    int screen_width;          // the size of the screen the frame was drawn on,
+    int screen_height;         // a resize does not always change the window
+    uint64_t screen_generation;// the generation of the screen after the last frame
+    uint64_t local_generation; // the generation of the language of the drawn texts
+    struct ncplane* terrain;   // the plane of the tiles that do not move, NULL while hidden
+    struct ncplane* entities;  // the plane of the player, the monsters and the items, NULL while hidden
+    uint8_t* terrain_cells;    // the drawn tile of every cell of the terrain plane, row-major
+    uint8_t* entity_cells;     // the drawn entity of every cell of the entity plane (PLAYER_CELL, NO_ENTITY or a tile)
+    uint64_t* seen;            // the seen bits of the drawn map (only the window is up to date)
+    size_t capacity;           // the number of cells that fit into both cell shadows
+    size_t seen_capacity;      // the number of words that fit into seen
+} map_view_t;
+
+map_view_t map_view = {NULL, 0, 0, 0, {0, 0}, {{0, 0}, 0, 0}, {0, 0}, 0, 0, 0, 0, 0, NULL, NULL, NULL, NULL, NULL, 0, 0};
+
+/**
+ * @brief How a tile looks on the screen.
+ */
+typedef struct {
+    const char* glyph;// NULL for values that are no tile
+    int length;       // the length of glyph in bytes
+    uint64_t channels;
+} tile_glyph_t;
+
+#define TILE_GLYPH_COUNT (HIDDEN + 1)
+
+// the glyph of every tile, indexed by the tile
+const tile_glyph_t tile_glyphs[TILE_GLYPH_COUNT] = {
+        [WALL] = {"#", 1, WALL_COLORS},
+        [FLOOR] = {" ", 1, FLOOR_COLORS},
+        [START_DOOR] = {"#", 1, START_DOOR_COLORS},
+        [EXIT_DOOR] = {"#", 1, EXIT_DOOR_COLORS},
+        [KEY] = {"$", 1, KEY_COLORS},
+        [LIFE_FOUNTAIN] = {"+", 1, LIFE_FOUNTAIN_COLORS},
+        [MANA_FOUNTAIN] = {"+", 1, MANA_FOUNTAIN_COLORS},
+        [GOBLIN] = {"!", 1, GOBLIN_COLORS},
+        [HIDDEN] = {" ", 1, HIDDEN_COLORS},
+};
+const tile_glyph_t unknown_tile_glyph = {" ", 1, DEFAULT_COLORS};
+const tile_glyph_t player_glyph = {"@", 1, RED_TEXT_COLORS};
+
+#define GLYPH_RUN_CAPACITY 256// the bytes of one batched write, including the terminator
+
+/**
+ * @brief Neighbouring glyphs of one row with the same colors, written with a single call.
+ */
+typedef struct {
+    struct ncplane* plane;
+    int y;// the row of the run within the plane
+    int x;// the first column of the run within the plane
+    int cells;
+    int length;// the number of used bytes of text
+    uint64_t channels;
+    char text[GLYPH_RUN_CAPACITY];
+} glyph_run_t;
+
+glyph_run_t terrain_run = {NULL, 0, 0, 0, 0, 0, {0}};
+
+/**
+ * @brief Moves the camera along one axis, so the player stays out of the outer quarters of the window.
+ * @param camera the first cell of the window on this axis
+ * @param size the size of the window on this axis
+ * @param map_size the size of the map on this axis
+ * @param player the position of the player on this axis
+ * @return the new first cell of the window
+ */
+int follow_axis(int camera, const int size, const int map_size, const int player) {
+    const int margin = size / 4;
+    if (player < camera + margin || player >= camera + size - margin) {
+        camera = player - size / 2;
+    }
+    if (camera > map_size - size) camera = map_size - size;
+    if (camera < 0) camera = 0;
+    return camera;
+}
+
+map_window_t follow_player(const map_window_t window, const int map_width, const int map_height, const int max_width,
+                           const int max_height, const vector2d_t player_pos) {
+    map_window_t next;
+    next.width = map_width < max_width ? map_width : max_width;
+    next.height = map_height < max_height ? map_height : max_height;
+    if (next.width < 1) next.width = 1;
+    if (next.height < 1) next.height = 1;
+    next.origin.dx = follow_axis(window.origin.dx, next.width, map_width, player_pos.dx);
+    next.origin.dy = follow_axis(window.origin.dy, next.height, map_height, player_pos.dy);
+    return next;
+}
+
+/**
+ * @brief Returns how the tile looks on the screen.
+ * @param tile the tile as the player knows it
+ * @return the entry of the tile in tile_glyphs
+ */
+const tile_glyph_t* get_tile_glyph(const map_tile_t tile) {
+    if ((unsigned) tile < TILE_GLYPH_COUNT && tile_glyphs[tile].glyph != NULL) return &tile_glyphs[tile];
+    log_msg(ERROR, "map_mode", "Unknown tile type: %d", tile);
+    return &unknown_tile_glyph;
+}
+
+/**
+ * @brief Writes the collected run onto its plane with a single call.
+ * @param run the run to write, empty afterwards
+ */
+void flush_glyph_run(glyph_run_t* run) {
+    if (run->cells == 0) return;
+    run->text[run->length] = '\0';
+    ncplane_set_channels(run->plane, run->channels);
+    ncplane_putstr_yx(run->plane, run->y, run->x, run->text);
+    run->cells = 0;
+    run->length = 0;
+}
+
+/**
+ * @brief Adds a glyph to the run, the run is written first if the glyph does not continue it.
+ * @param run the run to add to
+ * @param plane the plane of the glyph
+ * @param y the row within the plane
+ * @param x the column within the plane
+ * @param glyph the glyph to add
+ */
+void add_to_glyph_run(glyph_run_t* run, struct ncplane* plane, const int y, const int x, const tile_glyph_t* glyph) {
+    if (run->cells > 0 && (run->plane != plane || run->y != y || run->x + run->cells != x || run->channels != glyph->channels ||
+                           run->length + glyph->length >= GLYPH_RUN_CAPACITY)) {
+        flush_glyph_run(run);
+    }
+    if (run->cells == 0) {
+        run->plane = plane;
+        run->y = y;
+        run->x = x;
+        run->channels = glyph->channels;
+    }
+    memcpy(run->text + run->length, glyph->glyph, (size_t) glyph->length);
+    run->length += glyph->length;
+    run->cells++;
+}
+
+/**
+ * @brief Checks whether the tile is drawn on the entity plane.
+ * @param tile the tile as the player knows it
+ * @return 1 for monsters and items, 0 for the terrain
+ */
+int is_entity_tile(const map_tile_t tile) {
+    return tile == GOBLIN || tile == KEY;
+}
+
+/**
+ * @brief Prints a single glyph onto a plane of the map.
+ * @param plane the plane to print onto
+ * @param y the row within the plane
+ * @param x the column within the plane
+ * @param glyph the glyph to print
+ */
+void print_map_glyph(struct ncplane* plane, const int y, const int x, const tile_glyph_t* glyph) {
+    ncplane_set_channels(plane, glyph->channels);
+    ncplane_putstr_yx(plane, y, x, glyph->glyph);
+}
+
+/**
+ * @brief Draws a cell of the window on both planes, unless the same cell was drawn in the last frame.
+ * @param map the map to draw
+ * @param x the x coordinate of the cell
+ * @param y the y coordinate of the cell
+ * @param player_pos the position of the player
+ * @return the number of drawn plane cells
+ */
+int draw_map_cell(const map_t* map, const int x, const int y, const vector2d_t player_pos) {
+    const int window_x = x - map_view.window.origin.dx;
+    const int window_y = y - map_view.window.origin.dy;
+    if (window_x < 0 || window_x >= map_view.window.width || window_y < 0 || window_y >= map_view.window.height) return 0;
+
+    const map_tile_t tile = MAP_REVEALED(map, x, y);
+    const size_t index = (size_t) window_y * map_view.window.width + window_x;
+    int drawn = 0;
+
+    // monsters and items stand on the floor
+    const uint8_t terrain = is_entity_tile(tile) ? FLOOR : (uint8_t) tile;
+    if (map_view.terrain_cells[index] != terrain) {
+        map_view.terrain_cells[index] = terrain;
+        // cells are visited row by row, so neighbouring terrain is written together
+        add_to_glyph_run(&terrain_run, map_view.terrain, window_y, window_x, get_tile_glyph((map_tile_t) terrain));
+        drawn++;
+    }
+
+    const uint8_t entity = x == player_pos.dx && y == player_pos.dy ? PLAYER_CELL
+                           : is_entity_tile(tile)                  ? (uint8_t) tile
+                                                                   : NO_ENTITY;
+    if (map_view.entity_cells[index] != entity) {
+        map_view.entity_cells[index] = entity;
+        if (entity == PLAYER_CELL) {
+            print_map_glyph(map_view.entities, window_y, window_x, &player_glyph);
+        } else if (entity == NO_ENTITY) {
+            // the terrain below shows through again
+            ncplane_erase_region(map_view.entities, window_y, window_x, 1, 1);
+        } else {
+            print_map_glyph(map_view.entities, window_y, window_x, get_tile_glyph(tile));
+        }
+        drawn++;
+    }
+    return drawn;
+}
+
+/**
+ * @brief Makes sure the shadow can hold the given window of the map.
+ * @param map the map to draw
+ * @param window the window to draw
+ * @return COMMON_SUCCESS on success, a non-zero value if the shadow could not grow
+ */
+int reserve_map_view(const map_t* map, const map_window_t window) {
+    const size_t cells = (size_t) window.width * (size_t) window.height;
+    if (cells > map_view.capacity) {
+        uint8_t* terrain_cells = realloc(map_view.terrain_cells, cells);
+        NULL_PTR_HANDLER_RETURN(terrain_cells, 1, "Draw Map Mode", "Failed to grow the drawn cells to %zu", cells);
+        map_view.terrain_cells = terrain_cells;
+        uint8_t* entity_cells = realloc(map_view.entity_cells, cells);
+        NULL_PTR_HANDLER_RETURN(entity_cells, 1, "Draw Map Mode", "Failed to grow the drawn cells to %zu", cells);
+        map_view.entity_cells = entity_cells;
+        map_view.capacity = cells;
+    }
+    const size_t words = (size_t) map->row_words * (size_t) map->height;
+    if (words > map_view.seen_capacity) {
+        uint64_t* grown = realloc(map_view.seen, words * sizeof(uint64_t));
+        NULL_PTR_HANDLER_RETURN(grown, 1, "Draw Map Mode", "Failed to grow the drawn seen bits to %zu words", words);
+        map_view.seen = grown;
+        map_view.seen_capacity = words;
+    }
+    return COMMON_SUCCESS;
+}
+
+/**
+ * @brief Creates both planes of the map for the given window, the entity plane on top.
+ * @param anchor the position of the window on the screen
+ * @param window the window to draw
+ * @return COMMON_SUCCESS on success, a non-zero value if a plane could not be created
+ */
+int create_map_planes(const vector2d_t anchor, const map_window_t window) {
+    hide_map_mode();
+
+    struct ncplane_options opts = {0};
+    opts.y = anchor.dy;
+    opts.x = anchor.dx;
+    opts.rows = (unsigned) window.height;
+    opts.cols = (unsigned) window.width;
+    map_view.terrain = ncplane_create(gio->stdplane, &opts);
+    map_view.entities = map_view.terrain != NULL ? ncplane_create(gio->stdplane, &opts) : NULL;
+    if (map_view.entities == NULL) {
+        log_msg(ERROR, "Draw Map Mode", "Failed to create the planes of the map with %d x %d cells", window.width, window.height);
+        hide_map_mode();
+        return 1;
+    }
+
+    // the empty cells of the entity plane let the terrain show through
+    uint64_t transparent = 0;
+    ncchannels_set_fg_alpha(&transparent, NCALPHA_TRANSPARENT);
+    ncchannels_set_bg_alpha(&transparent, NCALPHA_TRANSPARENT);
+    ncplane_set_base(map_view.entities, "", 0, transparent);
+    return COMMON_SUCCESS;
+}
+
+void hide_map_mode(void) {
+    if (map_view.entities != NULL) ncplane_destroy(map_view.entities);
+    if (map_view.terrain != NULL) ncplane_destroy(map_view.terrain);
+    map_view.entities = NULL;
+    map_view.terrain = NULL;
+    // the next frame starts from an empty screen
+    map_view.map = NULL;
+}
+
+void shutdown_map_output(void) {
+    hide_map_mode();
+    free(map_view.terrain_cells);
+    free(map_view.entity_cells);
+    free(map_view.seen);
+    map_view.terrain_cells = NULL;
+    map_view.entity_cells = NULL;
+    map_view.seen = NULL;
+    map_view.capacity = 0;
+    map_view.seen_capacity = 0;
+}
+
+void draw_map_mode(const map_t* map, const vector2d_t anchor, const vector2d_t player_pos) {
+    NULL_PTR_HANDLER_RETURN(map, , "Draw Map Mode", "In draw_map_mode given map is NULL");
+    const int height = map->height;
+    const int width = map->width;
     CHECK_ARG_RETURN(height <= 0 || width <= 0, , "Draw Map Mode",
                      "In draw_map_mode given height or width is zero or negative");
     CHECK_ARG_RETURN(anchor.dx < 0 || anchor.dy < 0, , "Draw Map Mode", "In draw_map_mode given anchor is negative");
     CHECK_ARG_RETURN(player_pos.dx < 0 || player_pos.dy < 0 || player_pos.dx >= width || player_pos.dy >= height, ,
                      "Draw Map Mode", "In draw_map_mode given player position is negative or out of bounds");
 
-    // Print the title using centralized IO handler
-    char* map_title = get_local_string("MAP.TITLE");
-    print_text(anchor.dy, anchor.dx + width / 2 - 7, map_title, RED_TEXT_COLORS);
-    free(map_title);
-
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            // Setup channels (colors)
-            uint64_t channels = 0;
-            const char* ch;
-
-            if (x == player_pos.dx && y == player_pos.dy) {
-                // Player character - using centralized print_text
-                print_text(y + anchor.dy, x + anchor.dx, "@", RED_TEXT_COLORS);
-                continue;
-            }
+    // the window fills the screen right of and below the anchor, except for the player info
+    int screen_width = width + anchor.dx;
+    int screen_height = height + anchor.dy + PLAYER_INFO_HEIGHT;
+    get_screen_dimensions(&screen_width, &screen_height);
+    const map_window_t window = follow_player(map_view.window, width, height, screen_width - anchor.dx,
+                                              screen_height - anchor.dy - PLAYER_INFO_HEIGHT, player_pos);
 
-            //calculated access index
-            const int access_idx = x * height + y;
-
-            switch (arr[access_idx]) {
-                case WALL:
-                    channels = WALL_COLORS;
-                    ch = "#";
-                    break;
-                case FLOOR:
-                    channels = FLOOR_COLORS;
-                    ch = " ";
-                    break;
-                case START_DOOR:
-                    channels = START_DOOR_COLORS;
-                    ch = "#";
-                    break;
-                case EXIT_DOOR:
-                    channels = EXIT_DOOR_COLORS;
-                    ch = "#";
-                    break;
-                case KEY:
-                    channels = KEY_COLORS;
-                    ch = "$";
-                    break;
-                case LIFE_FOUNTAIN:
-                    channels = LIFE_FOUNTAIN_COLORS;
-                    ch = "+";
-                    break;
-                case MANA_FOUNTAIN:
-                    channels = MANA_FOUNTAIN_COLORS;
-                    ch = "+";
-                    break;
-                case GOBLIN:
-                    channels = GOBLIN_COLORS;
-                    ch = "!";
-                    break;
-                case HIDDEN:
-                    channels = HIDDEN_COLORS;
-                    ch = " ";
-                    break;
-                default:
-                    log_msg(ERROR, "map_mode", "Unknown tile type: %d", arr[access_idx]);
-                    ch = " ";
-                    channels = DEFAULT_COLORS;
-            }
+    // the words of the seen bits that hold the columns of the window
+    const int first_word = window.origin.dx / 64;
+    const int last_word = (window.origin.dx + window.width - 1) / 64;
+    const int y_end = window.origin.dy + window.height;
+    int drawn = 0;
+    if (map_view.map != map || map_view.width != width || map_view.height != height ||
+        map_view.anchor.dx != anchor.dx || map_view.anchor.dy != anchor.dy ||
+        memcmp(&map_view.window, &window, sizeof(map_window_t)) != 0 || map_view.screen_width != screen_width ||
+        map_view.screen_height != screen_height || map_view.screen_generation != get_screen_generation() ||
+        map_view.local_generation != get_local_generation()) {
+        // the screen was used by something else or resized, the camera moved or the language changed, start from an empty screen
+        if (reserve_map_view(map, window) != COMMON_SUCCESS) return;
+        clear_screen();
+        if (create_map_planes(anchor, window) != COMMON_SUCCESS) return;
+        map_view.map = map;
+        map_view.width = width;
+        map_view.height = height;
+        map_view.anchor = anchor;
+        map_view.window = window;
+        map_view.screen_width = screen_width;
+        map_view.screen_height = screen_height;
 
-            // Use centralized IO for printing
-            print_text(y + anchor.dy, x + anchor.dx, ch, channels);
+        // Print the title using centralized IO handler
+        print_text(anchor.dy, anchor.dx + window.width / 2 - 7, get_local_text_by_id(LOCAL_MAP_TITLE), RED_TEXT_COLORS);
+
+        // the new planes are empty, so every terrain cell is drawn
+        memset(map_view.terrain_cells, NOT_DRAWN, (size_t) window.width * (size_t) window.height);
+        memset(map_view.entity_cells, NO_ENTITY, (size_t) window.width * (size_t) window.height);
+        for (int y = window.origin.dy; y < y_end; y++) {
+            for (int x = window.origin.dx; x < window.origin.dx + window.width; x++) {
+                drawn += draw_map_cell(map, x, y, player_pos);
+            }
+        }
+    } else if (map_view.version != map->version) {
+        // the tiles changed, any cell can differ
+        for (int y = window.origin.dy; y < y_end; y++) {
+            for (int x = window.origin.dx; x < window.origin.dx + window.width; x++) {
+                drawn += draw_map_cell(map, x, y, player_pos);
+            }
+        }
+    } else {
+        // only newly seen tiles and the cells of the player can differ
+        for (int y = window.origin.dy; y < y_end; y++) {
+            for (int word = first_word; word <= last_word; word++) {
+                const size_t index = (size_t) y * map->row_words + word;
+                const uint64_t changed = map->seen[index] ^ map_view.seen[index];
+                if (changed == 0) continue;
+                for (int bit = 0; bit < 64; bit++) {
+                    if ((changed >> bit) & 1ULL) drawn += draw_map_cell(map, word * 64 + bit, y, player_pos);
+                }
+            }
         }
+        drawn += draw_map_cell(map, map_view.player.dx, map_view.player.dy, player_pos);
+        drawn += draw_map_cell(map, player_pos.dx, player_pos.dy, player_pos);
+    }
+    flush_glyph_run(&terrain_run);
+    for (int y = window.origin.dy; y < y_end; y++) {
+        const size_t row = (size_t) y * map->row_words;
+        memcpy(&map_view.seen[row + first_word], &map->seen[row + first_word],
+               (size_t) (last_word - first_word + 1) * sizeof(uint64_t));
     }
 
-    // Draw player info
-    draw_player_info(anchor.dx, anchor.dy + height + 1, player_pos);
+    if (drawn > 0 || map_view.floor != current_floor) {
+        draw_player_info(anchor.dx, anchor.dy + window.height + 1, player_pos);
+        drawn++;
+    }
+    map_view.version = map->version;
+    map_view.player = player_pos;
+    map_view.floor = current_floor;
+    map_view.screen_generation = get_screen_generation();
+    map_view.local_generation = get_local_generation();
 
-    // Render the frame using centralized IO
-    render_frame();
+    // Render the frame using centralized IO, only if something changed
+    if (drawn > 0) render_frame();
 }
 
 
@@ -108,15 +425,19 @@ void draw_player_info(int x, int y, const vector2d_t player_pos) {
     print_text_default(y++, x, map_mode_strings[PRESS_KEY_INVENTORY]);
 
     // Format current floor information
-    char* current_floor_text = get_local_string("MAP.CURRENT.FLOOR");
     char floor_str[64];
-    snprintf(floor_str, sizeof(floor_str), "%s %d", current_floor_text, current_floor);
+    snprintf(floor_str, sizeof(floor_str), "%s %d", get_local_text_by_id(LOCAL_MAP_CURRENT_FLOOR), current_floor);
     print_text_default(y++, x, floor_str);
-    free(current_floor_text);
 
     // Format player position string
     char pos_str[64];
     snprintf(pos_str, sizeof(pos_str), "%s: %d, %d", map_mode_strings[PLAYER_POSITION_STR], player_pos.dx, player_pos.dy);
+    // the previous position may have been longer and the screen is not cleared in between
+    const size_t pos_len = strlen(pos_str);
+    if (pos_len < PLAYER_INFO_WIDTH) {
+        memset(pos_str + pos_len, ' ', PLAYER_INFO_WIDTH - pos_len);
+        pos_str[PLAYER_INFO_WIDTH] = '\0';
+    }
     print_text_default(y + 2, x, pos_str);
 }
 
@@ -128,10 +449,8 @@ void draw_transition_screen(void) {
     // Clear the screen
     clear_screen();
 
-    char* transition_text = get_local_string("MAP.FLOOR.TRANSITION");
     char welcome_msg[256];
-    snprintf(welcome_msg, sizeof(welcome_msg), "%s", transition_text);
-    free(transition_text);
+    snprintf(welcome_msg, sizeof(welcome_msg), "%s", get_local_text_by_id(LOCAL_MAP_FLOOR_TRANSITION));
 
     int msg_len = strlen(welcome_msg);
     int msg_x = (width - msg_len) / 2;
@@ -8,24 +8,73 @@
 #include "../../../common.h"
 #include "../../../map/map.h"
 
+/**
+ * @brief The part of a map that is drawn on the screen.
+ */
+typedef struct {
+    vector2d_t origin;// the map cell at the top left corner of the window
+    int width;
+    int height;
+} map_window_t;
+
+/**
+ * @brief Moves the window of the map so that it follows the player.
+ *
+ * The window is as large as the map, but at most max_width x max_height cells. The window only
+ * moves when the player enters its outer quarters, then it is centered on the player again. It
+ * never reaches beyond the map.
+ *
+ * @param window The window of the last frame
+ * @param map_width The width of the map
+ * @param map_height The height of the map
+ * @param max_width The number of columns available on the screen
+ * @param max_height The number of rows available on the screen
+ * @param player_pos The position of the player
+ * @return The window of the next frame
+ */
+map_window_t follow_player(map_window_t window, int map_width, int map_height, int max_width, int max_height,
+                           vector2d_t player_pos);
+
 /**
  * @brief Draws the map mode UI based on the given parameters.
  *
- * @param arr The map array to be drawn
- * @param height The height of the map
- * @param width The width of the map
+ * Only the tiles the player has already seen are drawn, all others are drawn as hidden.
+ * Floors larger than the screen are drawn through a window that follows the player (see
+ * follow_player), so the cost depends on the size of the screen and not on the size of the floor.
+ * The terrain and the entities (player, monsters and items) are drawn onto two planes which
+ * notcurses composes. A shadow of the last frame is kept, so only the cells that changed since
+ * then (the player moved, tiles were seen for the first time or changed) are drawn and rendered.
+ * Everything is drawn again after the screen was cleared (see get_screen_generation) or resized
+ * or the map was hidden (see hide_map_mode).
+ *
+ * @param map The map to be drawn
  * @param anchor The anchor position of the map mode, defined as the top left corner
  * @param player_pos The position of the player
  *
  * @note This function checks makes different checks to ensure the given parameters are valid.
  * The checks are done in the following order:
- * - check if the array is NULL
+ * - check if the map is NULL
  * - check if the height and width are greater than 0
  * - check if the anchor position is greater or equal 0
  * - check if the player position is within the bounds of the map
  * If any of the checks fail, an error message is logged and the function returns.
  */
-void draw_map_mode(const map_tile_t* arr, int height, int width, vector2d_t anchor, vector2d_t player_pos);
+void draw_map_mode(const map_t* map, vector2d_t anchor, vector2d_t player_pos);
+
+/**
+ * @brief Removes the map from the screen, so another mode can use the screen.
+ *
+ * The map is drawn onto its own planes above the standard plane, which are not affected by
+ * clearing the screen. The next call of draw_map_mode draws the whole map again.
+ */
+void hide_map_mode(void);
+
+/**
+ * @brief Removes the map from the screen and frees the shadow of the last frame.
+ *
+ * Must be called before the io handler is shut down, as the planes of the map are destroyed.
+ */
+void shutdown_map_output(void);
 
 /**
  * @brief Draws the player information for the map mode.
@@ -20,7 +20,7 @@ static string_max_t* stats_menu_options;
 
 
 int init_stats_mode() {
-    stats_mode_strings = (char**) malloc(sizeof(char*) * MAX_STATS_STRINGS);
+    stats_mode_strings = (const char**) malloc(sizeof(char*) * MAX_STATS_STRINGS);
     RETURN_WHEN_NULL(stats_mode_strings, 1, "Stats Mode", "Failed to allocate memory for stats mode strings.")
 
     for (int i = 0; i < MAX_STATS_STRINGS; i++) {
@@ -121,11 +121,6 @@ void draw_stats_log(const char* message) {
 
 void shutdown_stats_mode() {
     if (stats_mode_strings != NULL) {
-        for (int i = 0; i < MAX_STATS_STRINGS; i++) {
-            if (stats_mode_strings[i] != NULL) {
-                free(stats_mode_strings[i]);
-            }
-        }
         free(stats_mode_strings);
     }
 }
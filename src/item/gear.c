@@ -10,7 +10,7 @@
 
 #include <stdio.h>
 
-char** gear_slot_names = NULL;
+const char** gear_slot_names = NULL;
 
 void update_gear_slot_local(void);
 
@@ -96,11 +96,6 @@ void free_gear_table(memory_pool_t* memory_pool, gear_table_t* table) {
     memory_pool_free(memory_pool, table);
 
     if (gear_slot_names != NULL) {
-        for (int i = 0; i < MAX_SLOT; i++) {
-            if (gear_slot_names[i] != NULL) {
-                free(gear_slot_names[i]);
-            }
-        }
         free(gear_slot_names);
         gear_slot_names = NULL;
     }
@@ -123,21 +118,15 @@ const char* gear_slot_to_string(const gear_slot_t slot) {
 void update_gear_slot_local(void) {
     if (gear_slot_names == NULL) return;// module not initialized
 
-    for (int i = 0; i < MAX_SLOT; i++) {
-        if (gear_slot_names[i] != NULL) {
-            free(gear_slot_names[i]);
-        }
-    }
-
-    gear_slot_names[SLOT_HEAD] = get_local_string("GEAR.SLOT.HEAD");
-    gear_slot_names[SLOT_CHEST] = get_local_string("GEAR.SLOT.CHEST");
-    gear_slot_names[SLOT_LEGS] = get_local_string("GEAR.SLOT.LEGS");
-    gear_slot_names[SLOT_FEET] = get_local_string("GEAR.SLOT.FEET");
-    gear_slot_names[SLOT_HANDS] = get_local_string("GEAR.SLOT.HANDS");
-    gear_slot_names[SLOT_NECK] = get_local_string("GEAR.SLOT.NECK");
-    gear_slot_names[SLOT_FINGER_RIGHT] = get_local_string("GEAR.SLOT.FINGER.RIGHT");
-    gear_slot_names[SLOT_FINGER_LEFT] = get_local_string("GEAR.SLOT.FINGER.LEFT");
-    gear_slot_names[SLOT_LEFT_HAND] = get_local_string("GEAR.SLOT.HAND.LEFT");
-    gear_slot_names[SLOT_RIGHT_HAND] = get_local_string("GEAR.SLOT.HAND.RIGHT");
-    gear_slot_names[SLOT_BOTH_HANDS] = get_local_string("GEAR.SLOT.HAND.BOTH");
+    gear_slot_names[SLOT_HEAD] = get_local_text_by_id(LOCAL_GEAR_SLOT_HEAD);
+    gear_slot_names[SLOT_CHEST] = get_local_text_by_id(LOCAL_GEAR_SLOT_CHEST);
+    gear_slot_names[SLOT_LEGS] = get_local_text_by_id(LOCAL_GEAR_SLOT_LEGS);
+    gear_slot_names[SLOT_FEET] = get_local_text_by_id(LOCAL_GEAR_SLOT_FEET);
+    gear_slot_names[SLOT_HANDS] = get_local_text_by_id(LOCAL_GEAR_SLOT_HANDS);
+    gear_slot_names[SLOT_NECK] = get_local_text_by_id(LOCAL_GEAR_SLOT_NECK);
+    gear_slot_names[SLOT_FINGER_RIGHT] = get_local_text_by_id(LOCAL_GEAR_SLOT_FINGER_RIGHT);
+    gear_slot_names[SLOT_FINGER_LEFT] = get_local_text_by_id(LOCAL_GEAR_SLOT_FINGER_LEFT);
+    gear_slot_names[SLOT_LEFT_HAND] = get_local_text_by_id(LOCAL_GEAR_SLOT_HAND_LEFT);
+    gear_slot_names[SLOT_RIGHT_HAND] = get_local_text_by_id(LOCAL_GEAR_SLOT_HAND_RIGHT);
+    gear_slot_names[SLOT_BOTH_HANDS] = get_local_text_by_id(LOCAL_GEAR_SLOT_HAND_BOTH);
 }
@@ -5,7 +5,7 @@
  * @var gear_names
  * Global array of strings representing the names of gear items.
  */
-extern char** gear_names;
+extern const char** gear_names;
 
 /**
  * @brief Initializes the local gear system.
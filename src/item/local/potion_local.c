@@ -4,7 +4,7 @@
 #include "../../logging/logger.h"
 #include "../potion.h"
 
-char** potion_names = NULL;
+const char** potion_names = NULL;
 
 void update_potion_local(void);
 
@@ -22,12 +22,6 @@ int init_potion_local(void) {
 
 void shutdown_potion_local(void) {
     if (potion_names != NULL) {
-        for (int i = 0; i < MAX_POTION_TYPES; i++) {
-            if (potion_names[i] != NULL) {
-                free(potion_names[i]);
-                potion_names[i] = NULL;
-            }
-        }
         free(potion_names);
         potion_names = NULL;
     }
@@ -35,13 +29,7 @@ void shutdown_potion_local(void) {
 
 void update_potion_local(void) {
     if (potion_names == NULL) return;// module not initialized
-    for (int i = 0; i < MAX_POTION_TYPES; i++) {
-        if (potion_names[i] != NULL) {
-            free(potion_names[i]);
-        }
-    }
-
-    potion_names[HEALING] = get_local_string("POTION.HEALTH");
-    potion_names[MANA] = get_local_string("POTION.MANA");
-    potion_names[STAMINA] = get_local_string("POTION.STAMINA");
+    potion_names[HEALING] = get_local_text_by_id(LOCAL_POTION_HEALTH);
+    potion_names[MANA] = get_local_text_by_id(LOCAL_POTION_MANA);
+    potion_names[STAMINA] = get_local_text_by_id(LOCAL_POTION_STAMINA);
 }
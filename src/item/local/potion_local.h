@@ -5,7 +5,7 @@
  * @var potion_names
  * Global array of strings representing the names of potion items.
  */
-extern char** potion_names;
+extern const char** potion_names;
 
 /**
  * @brief Initializes the local potion system.
@@ -9,7 +9,7 @@
 
 #include <stdio.h>
 
-char** potion_type_strings = NULL;
+const char** potion_type_strings = NULL;
 
 void update_potion_type_local(void);
 
@@ -73,11 +73,6 @@ void free_potion_table(memory_pool_t* memory_pool, potion_table_t* table) {
     memory_pool_free(memory_pool, table);
 
     if (potion_type_strings != NULL) {
-        for (int i = 0; i < MAX_POTION_TYPES; i++) {
-            if (potion_type_strings[i] != NULL) {
-                free(potion_type_strings[i]);
-            }
-        }
         free(potion_type_strings);
         potion_type_strings = NULL;
     }
@@ -86,13 +81,7 @@ void free_potion_table(memory_pool_t* memory_pool, potion_table_t* table) {
 void update_potion_type_local(void) {
     if (potion_type_strings == NULL) return;// module not initialized
 
-    for (int i = 0; i < MAX_POTION_TYPES; i++) {
-        if (potion_type_strings[i] != NULL) {
-            free(potion_type_strings[i]);
-        }
-    }
-
-    potion_type_strings[HEALING] = get_local_string("HEALTH");
-    potion_type_strings[MANA] = get_local_string("MANA");
-    potion_type_strings[STAMINA] = get_local_string("STAMINA");
+    potion_type_strings[HEALING] = get_local_text_by_id(LOCAL_HEALTH);
+    potion_type_strings[MANA] = get_local_text_by_id(LOCAL_MANA);
+    potion_type_strings[STAMINA] = get_local_text_by_id(LOCAL_STAMINA);
 }
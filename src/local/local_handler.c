@@ -4,20 +4,13 @@
  */
 #include "local_handler.h"
 
+#include "../common.h"
 #include "../logging/logger.h"
 
-#include <stdio.h>
+#include <stdatomic.h>
 #include <stdlib.h>
 #include <string.h>
 
-#ifdef _WIN32
-    #define PATH_SEP "\\"
-    #define LOCAL_DIRECTORY "resources\\local"
-#else
-    #define PATH_SEP "/"
-    #define LOCAL_DIRECTORY "resources/local"
-#endif//_WIN32
-
 typedef struct observer_node observer_node_t;
 
 typedef struct observer_node {
@@ -25,83 +18,106 @@ typedef struct observer_node {
     observer_node_t* next;
 } observer_node_t;
 
+// the bundles are generated in the order of the languages
+_Static_assert(LOCAL_LANG_COUNT == MAX_LANG, "local_bundle must be generated from one properties file per language");
+
+/**
+ * @brief The texts of one language as seen by the readers, published as a whole.
+ */
+typedef struct {
+    local_lang_t lang;
+    const char* const* texts;// indexed by local_key_t
+    uint64_t generation;
+} local_snapshot_t;
+
 observer_node_t* observer_list = NULL;
-FILE* local_file = NULL;
-local_lang_t current_lang;
+// the published snapshot and the buffer the next language is prepared in
+local_snapshot_t local_snapshots[2];
+_Atomic(const local_snapshot_t*) local_snapshot = NULL;
+// the generations of all snapshots, so a generation is never repeated after a restart of the handler
+uint64_t last_local_generation = 0;
+
+/**
+ * @brief Returns the published snapshot.
+ * @return the snapshot, NULL if the handler is not initialized
+ */
+const local_snapshot_t* current_snapshot(void) {
+    return atomic_load_explicit(&local_snapshot, memory_order_acquire);
+}
+
+/**
+ * @brief Prepares the snapshot of a language in the unused buffer and publishes it with a single pointer swap.
+ *
+ * The texts are compiled in, so a reader holding the previous snapshot keeps valid texts. Only the
+ * buffer of the previous snapshot is reused by the switch after the next one.
+ *
+ * @param lang the language to publish
+ */
+void publish_snapshot(const local_lang_t lang) {
+    const local_snapshot_t* current = atomic_load_explicit(&local_snapshot, memory_order_relaxed);
+    local_snapshot_t* next = current == &local_snapshots[0] ? &local_snapshots[1] : &local_snapshots[0];
+    *next = (local_snapshot_t) {lang, local_bundles[lang], ++last_local_generation};
+    atomic_store_explicit(&local_snapshot, next, memory_order_release);
+}
 
 int init_local_handler(const local_lang_t lang) {
-    if (local_file != NULL) {
+    if (current_snapshot() != NULL) {
         log_msg(WARNING, "Local", "Local handler is already initialized.");
         return 0;
     }
-
-    current_lang = lang;
-
-    char rel_path[128];
-    snprintf(rel_path, sizeof(rel_path), "%s" PATH_SEP "%s", LOCAL_DIRECTORY, local_file_mapping[lang].file_name);
-
-    local_file = fopen(rel_path, "r");
-    RETURN_WHEN_NULL(local_file, 1, "Local", "Failed to open local file.");
+    if (lang >= MAX_LANG) {
+        log_msg(WARNING, "Local", "Invalid language: %d.", lang);
+        return 1;
+    }
 
     observer_list = malloc(sizeof(observer_node_t));
     RETURN_WHEN_NULL(observer_list, 1, "Local", "Failed to allocate memory for observer list.");
 
     observer_list->update_func = NULL;
     observer_list->next = NULL;
+    publish_snapshot(lang);
     return 0;
 }
 
-char* get_local_string(const char* key) {
-    RETURN_WHEN_NULL(local_file, NULL, "Local", "Local handler is not initialized.");
-    static char line[512];
-    const size_t key_len = strlen(key);
-
-    rewind(local_file);
-
-    while (fgets(line, sizeof(line), local_file)) {
-        //if the line is empty or a comment, skip it
-        if (line[0] == '\n' || line[0] == '#') continue;
+const char* get_local_text(const char* key) {
+    const local_snapshot_t* snapshot = current_snapshot();
+    RETURN_WHEN_NULL(snapshot, key, "Local", "Local handler is not initialized.");
 
-        if (line[key_len] == '=') {
-            if (strncmp(line, key, key_len) == 0) {
-                // get the starting position
-                char* start = strchr(line, '"');
-                if (!start) continue;
+    const local_key_t id = find_local_key(key);
+    return id < LOCAL_KEY_COUNT ? snapshot->texts[id] : key;
+}
 
-                // get the end position
-                char* end = strchr(start + 1, '"');
-                if (!end) continue;
+const char* get_local_text_by_id(const local_key_t id) {
+    const local_snapshot_t* snapshot = current_snapshot();
+    RETURN_WHEN_NULL(snapshot, "", "Local", "Local handler is not initialized.");
+    CHECK_ARG_RETURN((unsigned) id >= LOCAL_KEY_COUNT, "", "Local", "Invalid local key id: %d.", id);
+    return snapshot->texts[id];
+}
 
-                const size_t len = end - (start + 1);
-                char* result = (char*) malloc(len + 1);
-                RETURN_WHEN_NULL(result, NULL, "Local", "Failed to allocate memory for local string.");
+uint64_t get_local_generation(void) {
+    const local_snapshot_t* snapshot = current_snapshot();
+    return snapshot != NULL ? snapshot->generation : 0;
+}
 
-                snprintf(result, len + 1, "%s", start + 1);
-                return result;
-            }
-        }
-    }
+char* get_local_string(const char* key) {
+    RETURN_WHEN_NULL(current_snapshot(), NULL, "Local", "Local handler is not initialized.");
 
-    return strdup(key);
+    char* result = strdup(get_local_text(key));
+    RETURN_WHEN_NULL(result, NULL, "Local", "Failed to allocate memory for local string.");
+    return result;
 }
 
 
 int set_language(const local_lang_t lang) {
-    RETURN_WHEN_NULL(local_file, 2, "Local", "Local handler is not initialized.");
+    RETURN_WHEN_NULL(current_snapshot(), 2, "Local", "Local handler is not initialized.");
 
     if (lang >= MAX_LANG) {
         log_msg(WARNING, "Local", "Invalid language: %d.", lang);
         return 2;
     }
-    current_lang = lang;
-    fclose(local_file);
-
-    char rel_path[128];
-    snprintf(rel_path, sizeof(rel_path), "%s" PATH_SEP "%s", LOCAL_DIRECTORY, local_file_mapping[lang].file_name);
-    local_file = fopen(rel_path, "r");
-    RETURN_WHEN_NULL(local_file, 1, "Local", "Failed to open local file.");
+    publish_snapshot(lang);
 
-    // go through the observer list
+    // go through the observer list, the observers only take the new texts by reference
     const observer_node_t* current = observer_list;
     while (current != NULL) {
         if (current->update_func != NULL) {
@@ -114,15 +130,16 @@ int set_language(const local_lang_t lang) {
 }
 
 local_lang_t get_language(void) {
-    if (local_file == NULL) {
+    const local_snapshot_t* snapshot = current_snapshot();
+    if (snapshot == NULL) {
         log_msg(WARNING, "Local", "Local handler is not initialized.");
         return LANGE_EN;// default to English if not initialized
     }
-    return current_lang;
+    return snapshot->lang;
 }
 
 void observe_local(void (*update_func)(void)) {
-    RETURN_WHEN_NULL(local_file, , "Local", "Local handler is not initialized.");
+    RETURN_WHEN_NULL(current_snapshot(), , "Local", "Local handler is not initialized.");
     RETURN_WHEN_NULL(update_func, , "Local", "Invalid observer function.");
 
     observer_node_t* new_node = malloc(sizeof(observer_node_t));
@@ -146,5 +163,6 @@ void shutdown_local_handler(void) {
         current = next;
     }
 
-    if (local_file != NULL) fclose(local_file);
+    observer_list = NULL;
+    atomic_store_explicit(&local_snapshot, NULL, memory_order_release);
 }
@@ -5,33 +5,60 @@
 #ifndef LOCAL_HANDLER_H
 #define LOCAL_HANDLER_H
 
+// generated at build time from resources/local/*.properties by tools/local_bundle.c
+#include "local_keys.h"
+
+#include <stdint.h>
+
 typedef enum {
     LANGE_EN,
     LANGE_DE,
     MAX_LANG
 } local_lang_t;
 
-static const struct {
-    local_lang_t lang;
-    char* file_name;
-} local_file_mapping[] = {
-        {LANGE_EN, "local_en.properties"},
-        {LANGE_DE, "local_de.properties"}};
-
 /**
- * Initialize the local language handler by setting up the language and opening the corresponding resource file.
+ * Initialize the local language handler by setting up the language and the observer list.
  *
- * This function initializes the handler to use the specified language. It opens the associated language file based
- * on a predefined mapping and prepares the observer list for updates. If the handler is already initialized, a warning
- * is logged and initialization is skipped.
+ * The texts of all languages are compiled into the game (see local_keys.h), so nothing is read or parsed.
+ * If the handler is already initialized, a warning is logged and initialization is skipped.
  *
  * @param lang the language to be set for the local handler
- * @return 0 on success, or 1 if the resource file cannot be opened
+ * @return 0 on success, or 1 if the language is invalid or the observer list cannot be allocated
  */
 int init_local_handler(local_lang_t lang);
 
 /**
- * Get the localized string for the given key.
+ * Get the localized text for the given key without copying it.
+ *
+ * The key is found with a perfect hash over the compiled keys, the lookup reads no file and allocates nothing.
+ * Prefer get_local_text_by_id for keys known at compile time.
+ *
+ * @param key the key for the localized string
+ * @return the localized string, if the key is not found or the handler is not initialized, returns the key itself
+ * @note The returned string must not be freed, it is valid for the whole run of the game.
+ */
+const char* get_local_text(const char* key);
+
+/**
+ * Get the localized text for the given key id without copying it.
+ *
+ * @param id the id of the key, e.g. LOCAL_MAP_TITLE for the key MAP.TITLE
+ * @return the localized string, an empty string if the id is invalid or the handler is not initialized
+ * @note The returned string must not be freed, it is valid for the whole run of the game.
+ */
+const char* get_local_text_by_id(local_key_t id);
+
+/**
+ * Get the generation of the current language, it changes with every set_language.
+ *
+ * Compare it to a stored generation to find out whether texts taken earlier are still in the current language.
+ *
+ * @return the generation, 0 if the handler is not initialized
+ */
+uint64_t get_local_generation(void);
+
+/**
+ * Get a copy of the localized string for the given key.
  *
  * @param key the key for the localized string
  * @return the localized string, if the key is not found, returns the key itself
@@ -43,13 +70,14 @@ char* get_local_string(const char* key);
  * Sets the current language for the local handler and updates all registered observers.
  *
  * This function updates the current language setting which determines the active language
- * file to be used. It attempts to close the current language file, opens the new associated
- * language resource file, and subsequently notifies the observer list by invoking their
- * respective update functions. The function ensures the validity of the input language and
- * handles errors related to file operations or uninitialized states.
+ * texts to be used. The texts of the new language are published with a single atomic pointer
+ * swap, so a concurrent reader sees either the old or the new language, and the generation
+ * changes. Subsequently the observer list is notified by invoking their respective update
+ * functions, which take the new texts by reference. The function ensures the validity of the
+ * input language and handles uninitialized states.
  *
  * @param lang the language to be set (e.g., LANGE_EN, LANGE_DE)
- * @return 0 on success, 1 if the specified language file cannot be opened, or 2 if the handler
+ * @return 0 on success, or 2 if the handler
  *         is not initialized or the language is invalid
  */
 int set_language(local_lang_t lang);
@@ -78,11 +106,10 @@ local_lang_t get_language(void);
 void observe_local(void (*update_func)(void));
 
 /**
- * Shut down the local language handler by releasing resources and closing the resource file.
+ * Shut down the local language handler by releasing its resources.
  *
  * This function deallocates all memory used by the observer list tied to the local handler. It ensures that
- * all dynamically allocated observer nodes are freed to prevent memory leaks. Additionally, it closes the
- * language resource file if it was previously opened.
+ * all dynamically allocated observer nodes are freed to prevent memory leaks.
  *
  * Proper usage of this function ensures a clean shutdown of the local language handler by releasing
  * occupied resources and leaving no lingering operations.
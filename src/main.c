@@ -18,6 +18,7 @@
 #include "item/local/potion_local.h"
 #include "local/local_handler.h"
 #include "logging/logger.h"
+#include "map/floor_pipeline.h"
 #include "map/local/map_mode_local.h"
 #include "map/map_mode.h"
 #include "menu/language_menu.h"
@@ -114,7 +115,15 @@ int init() {
 
 
     // Initialize map mode
-    init_map_mode();
+    if (init_map_mode() != COMMON_SUCCESS) {
+        log_msg(ERROR, "Main", "Failed to initialize map mode");
+        return FAIL_MAP_MODE_INIT;
+    }
+    // generates the next floor in the background
+    if (init_floor_pipeline() != COMMON_SUCCESS) {
+        log_msg(ERROR, "Main", "Failed to initialize floor pipeline");
+        return FAIL_FLOOR_PIPELINE_INIT;
+    }
     // the local modul for map mode
     if (init_map_mode_local() != COMMON_SUCCESS) return FAIL_MAP_MODE_LOCAL_INIT;
 
@@ -176,6 +185,7 @@ void shutdown_game() {
     shutdown_potion_local();
     shutdown_gear_local();
     shutdown_ability_local();
+    shutdown_floor_pipeline();
     shutdown_map_mode();
     shutdown_map_mode_local();
     shutdown_combat_mode();
@@ -26,6 +26,8 @@ typedef enum {
     FAIL_POTION_LOCAL_INIT,
     FAIL_DAMAGE_LOCAL_INIT,
     FAIL_ERROR,
+    FAIL_MAP_MODE_INIT,
+    FAIL_FLOOR_PIPELINE_INIT,
 } exit_code_t;
 
 /**
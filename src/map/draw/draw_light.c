@@ -6,172 +6,258 @@
 
 #include <stdlib.h>
 
-map_tile_t* map_arr;
-map_tile_t* revealed_map_arr;
-int map_height;
-int map_width;
-vector2d_t player_position;
-int radius;
+/**
+ * @brief The state of one field of view computation, shared by all scanned rows.
+ */
+typedef struct {
+    const map_tile_t* map_arr;// the tiles of the floor
+    int height;
+    int width;
+    vector2d_t origin;// the position of the player
+    int radius;       // the light radius (in steps, so the lit area is a diamond)
+    vector2d_t dir;   // the direction of the current quadrant
+    fov_visit_t visit;// called for every visible tile
+    void* data;       // passed to visit
+} fov_context_t;
 
 /**
- * Each array row corresponds to the vector in the directions array.
- * A row contains:
- * - the diagonal check vector
- * - the reverse check vector
+ * @brief The target of draw_light_on_player.
  */
-const vector2d_t checks_vector[4][2] = {
-        {{1, 1}, {1, 0}},   // for up
-        {{-1, -1}, {-1, 0}},// for down
-        {{1, -1}, {0, -1}}, // for left
-        {{-1, 1}, {0, 1}},  // for right
-};
+typedef struct {
+    const map_tile_t* map_arr;
+    map_tile_t* revealed_arr;
+    int width;
+} reveal_target_t;
 
+/**
+ * @brief The target of the placed lights in update_light.
+ */
+typedef struct {
+    map_t* map;
+    const light_map_t* lights;
+} lit_target_t;
 
 /**
- * @brief This is a helper function to check if the loop needs to break with this specific edge case.
- * @param x current tile x-coordinates
- * @param y current tile y-coordinates
- * @param dir the direction to check
- * @param j loop counter
- * @param prev_wall_at pointer to variable, which should be written
- * @return 1 if loops must break, 0 when not
+ * @brief A slope of the field of view as the fraction num / den, den is always positive.
  */
-int need_loop_break(const int x, const int y, const vector2d_t dir, int j, int* prev_wall_at) {
-    if (j == 0) {
-        //gets the x or y value of the calculated coordinates
-        *prev_wall_at = abs(y * dir.dy + x * dir.dx);
-        return 1;
-    }
-    if (*prev_wall_at == abs(y * dir.dy + x * dir.dx)) {
-        //if the previous j-loop had a wall at x or y coordinate, the loop must break
-        //or else diagonals tiles (behind a wall and not visible by the player) are revealed
-        return 1;
-    }
-    return 0;
-}
+typedef struct {
+    int num;
+    int den;
+} fov_slope_t;
 
+/**
+ * @brief Divides and rounds towards negative infinity (C rounds towards zero).
+ * @param a the dividend
+ * @param b the divisor, must be positive
+ * @return the rounded quotient
+ */
+int floor_div(const int a, const int b) {
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
 
 /**
- * @brief This function processes the tile at the given coordinates and updates the revealed_map_arr array.
- * @param x current tile x-coordinates
- * @param y current tile y-coordinates
- * @param prev_wall_at index of the previous wall tile
- * @param dir the direction to check
- * @param j loop counter
- * @return
+ * @brief Returns the first column of a row that lies within the slope, rounding ties (n + 0.5) up.
+ * @param depth the distance of the row from the player
+ * @param slope the start slope
+ * @return the first column
  */
-int process_tile(int x, int y, int* prev_wall_at, const vector2d_t dir, int j) {
-    int break_loop = 0;
-    //calculated access index
-    const int access_idx = x * map_height + y;
+int first_column(const int depth, const fov_slope_t slope) {
+    // floor(depth * num / den + 1/2)
+    return floor_div(2 * depth * slope.num + slope.den, 2 * slope.den);
+}
 
-    revealed_map_arr[access_idx] = map_arr[access_idx];
+/**
+ * @brief Returns the last column of a row that lies within the slope, rounding ties (n + 0.5) down.
+ * @param depth the distance of the row from the player
+ * @param slope the end slope
+ * @return the last column
+ */
+int last_column(const int depth, const fov_slope_t slope) {
+    // ceil(depth * num / den - 1/2)
+    return -floor_div(-(2 * depth * slope.num - slope.den), 2 * slope.den);
+}
 
-    if (map_arr[access_idx] == WALL) {
-        break_loop = need_loop_break(x, y, dir, j, prev_wall_at);
-    }
-    return break_loop;
+/**
+ * @brief Returns the slope of the edge of the tile towards the start of the row.
+ * @param depth the distance of the row from the player
+ * @param col the column of the tile
+ * @return the slope from the player to the edge of the tile
+ */
+fov_slope_t tile_edge_slope(const int depth, const int col) {
+    return (fov_slope_t) {2 * col - 1, 2 * depth};
 }
 
+/**
+ * @brief Checks if the center of the tile lies between both slopes, which keeps the field of view symmetric.
+ * @param depth the distance of the row from the player
+ * @param col the column of the tile
+ * @param start the start slope of the row
+ * @param end the end slope of the row
+ * @return 1 if the center is within both slopes, 0 otherwise
+ */
+int is_symmetric(const int depth, const int col, const fov_slope_t start, const fov_slope_t end) {
+    return col * start.den >= depth * start.num && col * end.den <= depth * end.num;
+}
 
 /**
- * @brief This function checks if the tile at the given coordinates is valid and processes it.
- * @param x current tile x-coordinates
- * @param y current tile y-coordinates
- * @param prev_wall_at index of the previous wall tile
- * @param dir the direction to check
- * @param j loop counter
- * @param diagonal_check the diagonal check vector
- * @param reverse_check the reverse check vector
- * @return 1 if loops must break, 0 when not
+ * @brief Scans one row of the current quadrant and continues with the next row for every visible gap.
+ *
+ * The rows of a quadrant are the lines at the same distance from the player, the columns run
+ * across them. Walls cast a shadow onto the following rows by narrowing the slopes, so every tile
+ * of the quadrant within the radius is looked at once. The tiles on the end diagonal (col == depth)
+ * belong to the next quadrant and are not visited. The recursion depth is at most the radius.
+ *
+ * @param ctx the state of the field of view
+ * @param depth the distance of the row from the player
+ * @param start the slope at which the visible part of the row starts
+ * @param end the slope at which the visible part of the row ends
  */
-int check_and_process_tile(int x, int y, int* prev_wall_at, const vector2d_t dir, int j,
-                           const vector2d_t diagonal_check, const vector2d_t reverse_check) {
-    int quit = 0;
-    //calculated access index
-    const int access_idx = x * map_height + y;
-
-    if (x < 0 || x >= map_width || y < 0 || y >= map_height) {
-        //calculated x or y is out of bounds
-        quit = 1;
-    } else {
-        if (revealed_map_arr[access_idx] == HIDDEN) {
-            //initialize the relative diagonal and reverse tiles based on the y and x values
-            const int rel_diagonal = map_arr[(x + diagonal_check.dx) * map_height + y + diagonal_check.dy];
-            const int rel_reverse = map_arr[(x + reverse_check.dx) * map_height + y + reverse_check.dy];
-
-            if (rel_diagonal == WALL && rel_reverse == WALL && j > 1) {
-                //if the diagonal and reverse tiles are walls and the distance from the player is greater than 1
-                // then the tile must be hidden because reverse tile is blocking the view
-                quit = 1;
-            } else {
-                quit = process_tile(x, y, prev_wall_at, dir, j);
-            }
-        } else if (revealed_map_arr[access_idx] == WALL && need_loop_break(x, y, dir, j, prev_wall_at)) {
-            quit = 1;
+void scan_row(const fov_context_t* ctx, const int depth, fov_slope_t start, const fov_slope_t end) {
+    if (depth > ctx->radius) return;
+
+    // the light reaches radius steps, so the rows get shorter with the distance
+    const int limit = ctx->radius - depth;
+    int min_col = first_column(depth, start);
+    int max_col = last_column(depth, end);
+    if (min_col < -limit) min_col = -limit;
+    if (max_col > limit) max_col = limit;
+
+    int prev_is_wall = -1;// no previous tile in this row yet
+    for (int col = min_col; col <= max_col; col++) {
+        const int x = ctx->origin.dx + ctx->dir.dx * depth - ctx->dir.dy * col;
+        const int y = ctx->origin.dy + ctx->dir.dy * depth + ctx->dir.dx * col;
+        const int in_bounds = x >= 0 && x < ctx->width && y >= 0 && y < ctx->height;
+        const int access_idx = y * ctx->width + x;
+        // outside of the map counts as wall, but is never revealed
+        const int is_wall = !in_bounds || ctx->map_arr[access_idx] == WALL;
+
+        // the tile on the end diagonal is visited by the next quadrant, where it lies on the start diagonal,
+        // it is still scanned here, so its wall casts the same shadow
+        if (in_bounds && col < depth && (is_wall || is_symmetric(depth, col, start, end))) {
+            ctx->visit(ctx->data, x, y, depth + abs(col));
         }
+        if (prev_is_wall == 1 && !is_wall) {
+            // a gap after a wall, the light starts again at the edge of this tile
+            start = tile_edge_slope(depth, col);
+        } else if (prev_is_wall == 0 && is_wall) {
+            // a wall after a gap, the gap lights the next row up to the edge of the wall
+            scan_row(ctx, depth + 1, start, tile_edge_slope(depth, col));
+        }
+        prev_is_wall = is_wall;
+    }
+    if (prev_is_wall == 0) {
+        scan_row(ctx, depth + 1, start, end);
     }
-    return quit;
 }
 
+/**
+ * @brief Scans all four quadrants around the origin of the context.
+ * @param ctx the state of the field of view, the direction is overwritten
+ */
+void cast_light(fov_context_t* ctx) {
+    for (int i = 0; i < 4; i++) {
+        // every quadrant scans the diagonals on both sides of its direction, but only visits the start diagonal
+        ctx->dir = directions[i];
+        scan_row(ctx, 1, (fov_slope_t) {-1, 1}, (fov_slope_t) {1, 1});
+    }
+}
+
+void cast_field_of_view(const map_tile_t* tiles, const int height, const int width, const vector2d_t origin,
+                        const int radius, const fov_visit_t visit, void* data) {
+    if (radius <= 0) return;
+
+    fov_context_t ctx = {tiles, height, width, origin, radius, {0, 0}, visit, data};
+    cast_light(&ctx);
+}
 
 /**
- * @brief Processes light in a specific direction and updates the revealed map_arr.
- * @param player the player's position on the map_arr
- * @param dir the direction vector
- * @param diagonal_check the diagonal check vector
- * @param reverse_check the reverse check vector
- * @param light_radius the radius of the light around the player
+ * @brief Copies a visible tile to the revealed tiles.
+ * @param data the reveal_target_t
+ * @param x the x coordinate of the tile
+ * @param y the y coordinate of the tile
+ * @param steps unused
  */
-void process_light_in_direction(const vector2d_t player, const vector2d_t dir, const vector2d_t diagonal_check,
-                                const vector2d_t reverse_check, const int light_radius) {
-    int correction = 0;
-    int prev_wall_at = -1;
-
-    for (int j = 0; j <= light_radius; j++) {
-        const int start_x = player.dx + j * dir.dy;
-        int start_y = player.dy + j * dir.dx;
-
-        if (dir.dx != 0) {
-            //if the direction is vertical negate the subtrahend
-            start_y = player.dy - j * dir.dx;
-        }
+void reveal_tile(void* data, const int x, const int y, const int steps) {
+    (void) steps;
+    const reveal_target_t* target = data;
+    target->revealed_arr[y * target->width + x] = target->map_arr[y * target->width + x];
+}
 
-        if (start_x < 0 || start_x >= map_width || start_y < 0 || start_y >= map_height) {
-            //start position is out of bounds, skip to the next direction
-            break;
-        }
-        for (int k = 1; k <= light_radius - correction; k++) {
-            const int x = start_x + k * dir.dx;
-            const int y = start_y + k * dir.dy;
+/**
+ * @brief Sets the visible bit of a lit tile.
+ * @param data the map_t
+ * @param x the x coordinate of the tile
+ * @param y the y coordinate of the tile
+ * @param steps unused
+ */
+void set_visible_bit(void* data, const int x, const int y, const int steps) {
+    (void) steps;
+    map_t* map = data;
+    map->visible[y * map->row_words + x / 64] |= 1ULL << (x % 64);
+}
 
-            if (check_and_process_tile(x, y, &prev_wall_at, dir, j, diagonal_check, reverse_check)) {
-                break;
-            }
-        }
-        correction++;
-    }
+/**
+ * @brief Sets the visible bit of a tile in sight, if a placed light reaches it.
+ * @param data the lit_target_t
+ * @param x the x coordinate of the tile
+ * @param y the y coordinate of the tile
+ * @param steps unused
+ */
+void set_lit_visible_bit(void* data, const int x, const int y, const int steps) {
+    const lit_target_t* target = data;
+    if (LIGHT_AT(target->lights, x, y) > 0) set_visible_bit(target->map, x, y, steps);
 }
 
 void draw_light_on_player(map_tile_t* arr1, map_tile_t* arr2, int height, int width, vector2d_t player,
                           const int light_radius) {
-    map_arr = arr1;
-    revealed_map_arr = arr2;
-    map_height = height;
-    map_width = width;
-    player_position = player;
-    radius = light_radius;
-
     if (light_radius <= 0) {
         //light radius is negative or 0, do nothing
         return;
     }
 
-    for (int i = 0; i < 4; i++) {
-        const vector2d_t dir = directions[i];
-        const vector2d_t diagonal_check = checks_vector[i][0];
-        const vector2d_t reverse_check = checks_vector[i][1];
+    reveal_target_t target = {arr1, arr2, width};
+    cast_field_of_view(arr1, height, width, player, light_radius, reveal_tile, &target);
+}
 
-        process_light_in_direction(player, dir, diagonal_check, reverse_check, light_radius);
+int update_light(light_cache_t* cache, map_t* map, const light_map_t* lights, const vector2d_t player,
+                 const int light_radius, const int sight_radius) {
+    NULL_PTR_HANDLER_RETURN(cache, 0, "draw_light", "In update_light given cache is NULL");
+    NULL_PTR_HANDLER_RETURN(map, 0, "draw_light", "In update_light given map is NULL");
+    CHECK_ARG_RETURN(lights != NULL && (lights->width != map->width || lights->height != map->height), 0, "draw_light",
+                     "Light map of %d x %d does not fit a %d x %d floor", lights->width, lights->height, map->width, map->height);
+
+    const uint64_t lights_version = lights != NULL ? lights->version : 0;
+    if (cache->map == map && cache->version == map->version && cache->player.dx == player.dx &&
+        cache->player.dy == player.dy && cache->light_radius == light_radius && cache->lights == lights &&
+        cache->lights_version == lights_version && cache->sight_radius == sight_radius) {
+        return 0;
+    }
+    if (cache->map == map) {
+        // only the previous light can still be visible
+        const int sight = cache->lights != NULL ? cache->sight_radius : 0;
+        const int reach = cache->light_radius > sight ? cache->light_radius : sight;
+        clear_visible_area(map, cache->player.dx - reach, cache->player.dy - reach, cache->player.dx + reach,
+                           cache->player.dy + reach);
+    } else {
+        clear_visible_area(map, 0, 0, map->width - 1, map->height - 1);
+    }
+
+    cast_field_of_view(map->tiles, map->height, map->width, player, light_radius, set_visible_bit, map);
+    if (lights != NULL) {
+        lit_target_t target = {map, lights};
+        cast_field_of_view(map->tiles, map->height, map->width, player, sight_radius, set_lit_visible_bit, &target);
+    }
+    const int sight = lights != NULL ? sight_radius : 0;
+    const int reach = light_radius > sight ? light_radius : sight;
+    if (reach > 0) {
+        merge_visible_area(map, player.dx - reach, player.dy - reach, player.dx + reach, player.dy + reach);
     }
+    cache->map = map;
+    cache->version = map->version;
+    cache->player = player;
+    cache->light_radius = light_radius;
+    cache->lights = lights;
+    cache->lights_version = lights_version;
+    cache->sight_radius = sight_radius;
+    return 1;
 }
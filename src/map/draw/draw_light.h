@@ -6,12 +6,43 @@
 #define DRAW_LIGHT_H
 
 #include "../map.h"
+#include "light_map.h"
+
+/**
+ * @brief Called for every tile a field of view reaches.
+ *
+ * @param data The data given to cast_field_of_view
+ * @param x The x coordinate of the tile
+ * @param y The y coordinate of the tile
+ * @param steps The number of steps from the origin to the tile
+ */
+typedef void (*fov_visit_t)(void* data, int x, int y, int steps);
+
+/**
+ * @brief Visits every tile that can be seen from the origin, using the shadowcasting of draw_light_on_player.
+ *
+ * @param tiles The row-major tiles of the map
+ * @param height The height of the map
+ * @param width The width of the map
+ * @param origin The position to look from, the origin itself is not visited, every other tile at most once
+ * @param radius The number of steps the view reaches
+ * @param visit The function to call for every visible tile
+ * @param data Passed to visit
+ */
+void cast_field_of_view(const map_tile_t* tiles, int height, int width, vector2d_t origin, int radius, fov_visit_t visit,
+                        void* data);
 
 /**
  * @brief Draws light around the player.
  *
- * @param arr1 The pointer to the 2D array containing all the map tiles (no Hidden tiles)
- * @param arr2 The pointer to the 2D array to reveal the arr1, based on the player's position and light radius
+ * Uses symmetric shadowcasting: the area around the player is split into four quadrants which
+ * are scanned row by row, walls narrow the visible part of the following rows. The light reaches
+ * light_radius steps from the player, so the cost grows with light_radius^2 and not with the size
+ * of the map. Walls and tiles whose center can be seen are copied from arr1 to arr2, the tile of
+ * the player itself is not revealed.
+ *
+ * @param arr1 The pointer to the row-major tile buffer containing all the map tiles (no Hidden tiles)
+ * @param arr2 The pointer to the row-major tile buffer to reveal the arr1, based on the player's position and light radius
  * @param height The height of the map
  * @param width The width of the map
  * @param player The player's position on the map
@@ -20,4 +51,39 @@
 void draw_light_on_player(map_tile_t* arr1, map_tile_t* arr2, int height, int width, vector2d_t player,
                           int light_radius);
 
+/**
+ * @brief The key of the last light drawn on a map.
+ */
+typedef struct {
+    const map_t* map;// the map the light was drawn on, NULL if no light was drawn yet
+    uint64_t version;// the version of the map at that time
+    vector2d_t player;
+    int light_radius;
+    const light_map_t* lights;// the placed lights at that time, NULL if there were none
+    uint64_t lights_version;  // the version of the placed lights
+    int sight_radius;
+} light_cache_t;
+
+#define LIGHT_CACHE_EMPTY {NULL, 0, {0, 0}, 0, NULL, 0, 0}
+
+/**
+ * @brief Draws light around the player, unless the same light was already drawn on the map.
+ *
+ * The lit tiles are stored in the visible bits of the map and merged into its seen bits. Tiles
+ * lit by a placed light source are visible as well, if the player can see them within the sight
+ * radius. The light only depends on the tiles, the player position, the radii and the placed
+ * lights. As long as none of them changed (see mark_map_changed), the bits already contain the
+ * light and no work is done.
+ *
+ * @param cache The key of the last drawn light, updated when the light is drawn
+ * @param map The map to draw the light on
+ * @param lights The placed lights of the map, NULL if there are none
+ * @param player The player's position on the map
+ * @param light_radius The radius of the light around the player
+ * @param sight_radius The number of steps the player can see tiles lit by placed lights
+ * @return 1 if the light was drawn, 0 if the cached light was still valid
+ */
+int update_light(light_cache_t* cache, map_t* map, const light_map_t* lights, vector2d_t player, int light_radius,
+                 int sight_radius);
+
 #endif//DRAW_LIGHT_H
@@ -0,0 +1,254 @@
+/**
+ * @file light_map.c
+ * @brief Implements the light map of the placed light sources.
+ */
+#include "light_map.h"
+
+#include "../../logging/logger.h"
+#include "draw_light.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define SOURCE_INITIAL_CAPACITY 16
+
+// the versions of all light maps, so a reused light map never repeats a version
+uint64_t last_light_version = 0;
+
+/**
+ * @brief The light source together with the width of the map it lights.
+ */
+typedef struct {
+    light_source_t* source;
+    int width;
+    int failed;// set if a lit cell could not be cached
+} light_target_t;
+
+/**
+ * @brief Returns the light of a source after the given number of steps.
+ * @param source the source
+ * @param steps the number of steps from the source
+ * @return the amount of light, at least 1 within the radius
+ */
+int light_falloff(const light_source_t* source, const int steps) {
+    const int amount = source->intensity * (source->radius + 1 - steps) / (source->radius + 1);
+    return amount > 0 ? amount : 1;
+}
+
+/**
+ * @brief Adds one cell to the cached light of a source, the cache grows as needed.
+ * @param source the source to add the cell to
+ * @param cell the row-major index of the cell
+ * @param amount the light of the source on the cell
+ * @return COMMON_SUCCESS on success, a non-zero value if the cache could not grow
+ */
+int add_lit_cell(light_source_t* source, const int cell, const int amount) {
+    if (source->cell_count == source->cell_capacity) {
+        const int capacity = source->cell_capacity > 0 ? source->cell_capacity * 2 : 64;
+        int* cells = realloc(source->cells, (size_t) capacity * sizeof(int));
+        NULL_PTR_HANDLER_RETURN(cells, 1, "light_map", "Failed to grow the light of a source to %d cells", capacity);
+        source->cells = cells;
+        uint8_t* amounts = realloc(source->amounts, (size_t) capacity * sizeof(uint8_t));
+        NULL_PTR_HANDLER_RETURN(amounts, 1, "light_map", "Failed to grow the light of a source to %d cells", capacity);
+        source->amounts = amounts;
+        source->cell_capacity = capacity;
+    }
+    source->cells[source->cell_count] = cell;
+    source->amounts[source->cell_count] = (uint8_t) amount;
+    source->cell_count++;
+    return COMMON_SUCCESS;
+}
+
+/**
+ * @brief Adds the light of a lit cell to the cached light of the source.
+ * @param data the light_target_t
+ * @param x the x coordinate of the cell
+ * @param y the y coordinate of the cell
+ * @param steps the number of steps from the source to the cell
+ */
+void collect_lit_cell(void* data, const int x, const int y, const int steps) {
+    light_target_t* target = data;
+    if (add_lit_cell(target->source, y * target->width + x, light_falloff(target->source, steps)) != COMMON_SUCCESS) {
+        target->failed = 1;
+    }
+}
+
+/**
+ * @brief Casts the light of a source and caches the lit cells (without adding them to the light map).
+ * @param lights the light map of the source
+ * @param map the map the light is cast on
+ * @param source the source to cast
+ * @return COMMON_SUCCESS on success, a non-zero value if the cache could not grow
+ */
+int cast_source(const light_map_t* lights, const map_t* map, light_source_t* source) {
+    source->cell_count = 0;
+    if (add_lit_cell(source, source->pos.dy * lights->width + source->pos.dx, source->intensity) != COMMON_SUCCESS) {
+        return 1;
+    }
+    // every cell is visited once, so it is lit once
+    light_target_t target = {source, lights->width, 0};
+    cast_field_of_view(map->tiles, map->height, map->width, source->pos, source->radius, collect_lit_cell, &target);
+    return target.failed;
+}
+
+/**
+ * @brief Adds the cached light of a source to the light map.
+ * @param lights the light map
+ * @param source the source
+ */
+void apply_source(const light_map_t* lights, const light_source_t* source) {
+    for (int i = 0; i < source->cell_count; i++) {
+        lights->intensity[source->cells[i]] += source->amounts[i];
+    }
+}
+
+/**
+ * @brief Takes the cached light of a source out of the light map.
+ * @param lights the light map
+ * @param source the source
+ */
+void unapply_source(const light_map_t* lights, const light_source_t* source) {
+    for (int i = 0; i < source->cell_count; i++) {
+        lights->intensity[source->cells[i]] -= source->amounts[i];
+    }
+}
+
+/**
+ * @brief Checks whether the position lies on the light map.
+ * @param lights the light map
+ * @param pos the position
+ * @return 1 if the position is on the map, 0 otherwise
+ */
+int is_on_light_map(const light_map_t* lights, const vector2d_t pos) {
+    return pos.dx >= 0 && pos.dx < lights->width && pos.dy >= 0 && pos.dy < lights->height;
+}
+
+light_map_t* init_light_map(const int width, const int height) {
+    CHECK_ARG_RETURN(width <= 0 || height <= 0, NULL, "light_map", "Invalid light map size %d x %d", width, height);
+    light_map_t* lights = malloc(sizeof(light_map_t));
+    NULL_PTR_HANDLER_RETURN(lights, NULL, "light_map", "Failed to allocate memory for the light map");
+
+    lights->intensity = calloc((size_t) width * (size_t) height, sizeof(uint32_t));
+    lights->sources = malloc(SOURCE_INITIAL_CAPACITY * sizeof(light_source_t));
+    if (lights->intensity == NULL || lights->sources == NULL) {
+        log_msg(ERROR, "light_map", "Failed to allocate the light map for a %d x %d floor", width, height);
+        free(lights->intensity);
+        free(lights->sources);
+        free(lights);
+        return NULL;
+    }
+    lights->width = width;
+    lights->height = height;
+    lights->source_count = 0;
+    lights->source_capacity = SOURCE_INITIAL_CAPACITY;
+    lights->version = ++last_light_version;
+    return lights;
+}
+
+void free_light_map(light_map_t* lights) {
+    if (lights == NULL) return;
+    for (int i = 0; i < lights->source_count; i++) {
+        free(lights->sources[i].cells);
+        free(lights->sources[i].amounts);
+    }
+    free(lights->sources);
+    free(lights->intensity);
+    free(lights);
+}
+
+void clear_light_map(light_map_t* lights) {
+    NULL_PTR_HANDLER_RETURN(lights, , "light_map", "In clear_light_map given light map is NULL");
+    for (int i = 0; i < lights->source_count; i++) {
+        free(lights->sources[i].cells);
+        free(lights->sources[i].amounts);
+    }
+    lights->source_count = 0;
+    memset(lights->intensity, 0, (size_t) lights->width * (size_t) lights->height * sizeof(uint32_t));
+    lights->version = ++last_light_version;
+}
+
+int add_light_source(light_map_t* lights, const map_t* map, const vector2d_t pos, const int radius, const int intensity) {
+    NULL_PTR_HANDLER_RETURN(lights, NO_LIGHT_SOURCE, "light_map", "In add_light_source given light map is NULL");
+    NULL_PTR_HANDLER_RETURN(map, NO_LIGHT_SOURCE, "light_map", "In add_light_source given map is NULL");
+    CHECK_ARG_RETURN(lights->width != map->width || lights->height != map->height, NO_LIGHT_SOURCE, "light_map",
+                     "Light map of %d x %d does not fit a %d x %d floor", lights->width, lights->height, map->width, map->height);
+    CHECK_ARG_RETURN(!is_on_light_map(lights, pos), NO_LIGHT_SOURCE, "light_map", "Light source at (%d, %d) is outside of the map",
+                     pos.dx, pos.dy);
+    CHECK_ARG_RETURN(radius <= 0 || intensity <= 0 || intensity > MAX_LIGHT_INTENSITY, NO_LIGHT_SOURCE, "light_map",
+                     "Invalid light source with radius %d and intensity %d", radius, intensity);
+
+    if (lights->source_count == lights->source_capacity) {
+        const int capacity = lights->source_capacity * 2;
+        light_source_t* sources = realloc(lights->sources, (size_t) capacity * sizeof(light_source_t));
+        NULL_PTR_HANDLER_RETURN(sources, NO_LIGHT_SOURCE, "light_map", "Failed to grow the light sources to %d", capacity);
+        lights->sources = sources;
+        lights->source_capacity = capacity;
+    }
+    light_source_t* source = &lights->sources[lights->source_count];
+    *source = (light_source_t) {pos, radius, intensity, NULL, NULL, 0, 0};
+    if (cast_source(lights, map, source) != COMMON_SUCCESS) {
+        free(source->cells);
+        free(source->amounts);
+        return NO_LIGHT_SOURCE;
+    }
+    apply_source(lights, source);
+    lights->version = ++last_light_version;
+    return lights->source_count++;
+}
+
+int move_light_source(light_map_t* lights, const map_t* map, const int id, const vector2d_t pos) {
+    NULL_PTR_HANDLER_RETURN(lights, 1, "light_map", "In move_light_source given light map is NULL");
+    NULL_PTR_HANDLER_RETURN(map, 1, "light_map", "In move_light_source given map is NULL");
+    CHECK_ARG_RETURN(id < 0 || id >= lights->source_count || lights->sources[id].radius == 0, 1, "light_map",
+                     "Invalid light source id %d", id);
+    CHECK_ARG_RETURN(!is_on_light_map(lights, pos), 1, "light_map", "Light source at (%d, %d) is outside of the map",
+                     pos.dx, pos.dy);
+
+    light_source_t* source = &lights->sources[id];
+    unapply_source(lights, source);
+    source->pos = pos;
+    const int result = cast_source(lights, map, source);
+    apply_source(lights, source);
+    lights->version = ++last_light_version;
+    return result;
+}
+
+void remove_light_source(light_map_t* lights, const int id) {
+    NULL_PTR_HANDLER_RETURN(lights, , "light_map", "In remove_light_source given light map is NULL");
+    CHECK_ARG_RETURN(id < 0 || id >= lights->source_count || lights->sources[id].radius == 0, , "light_map",
+                     "Invalid light source id %d", id);
+
+    light_source_t* source = &lights->sources[id];
+    unapply_source(lights, source);
+    source->radius = 0;
+    source->cell_count = 0;
+    lights->version = ++last_light_version;
+}
+
+int update_light_area(light_map_t* lights, const map_t* map, const int x_min, const int y_min, const int x_max,
+                      const int y_max) {
+    NULL_PTR_HANDLER_RETURN(lights, 0, "light_map", "In update_light_area given light map is NULL");
+    NULL_PTR_HANDLER_RETURN(map, 0, "light_map", "In update_light_area given map is NULL");
+
+    int updated = 0;
+    int failed = 0;
+    for (int i = 0; i < lights->source_count; i++) {
+        light_source_t* source = &lights->sources[i];
+        // a tile outside of the reach of the source can neither block nor let through its light
+        if (source->radius == 0 || source->pos.dx + source->radius < x_min || source->pos.dx - source->radius > x_max ||
+            source->pos.dy + source->radius < y_min || source->pos.dy - source->radius > y_max) {
+            continue;
+        }
+        unapply_source(lights, source);
+        // a source that failed still applies the cells it cached, so it can be taken out again
+        if (cast_source(lights, map, source) != COMMON_SUCCESS) failed = 1;
+        apply_source(lights, source);
+        updated++;
+    }
+    if (updated > 0) lights->version = ++last_light_version;
+    if (failed) {
+        log_msg(ERROR, "light_map", "Failed to cast the light of a source again, the light map is incomplete");
+        return -1;
+    }
+    return updated;
+}
@@ -0,0 +1,129 @@
+/**
+ * @file light_map.h
+ * @brief Exposes the light map, which gathers the light of many placed light sources.
+ */
+#ifndef LIGHT_MAP_H
+#define LIGHT_MAP_H
+
+#include "../map.h"
+
+#include <stdint.h>
+
+#define MAX_LIGHT_INTENSITY 255
+#define NO_LIGHT_SOURCE (-1)
+
+/**
+ * @brief A placed light source (e.g. a fountain, a torch or a glowing monster).
+ *
+ * The light of a source is computed once and kept as a list of cells and amounts, so the source
+ * can be taken out of the light map again without casting its light a second time.
+ */
+typedef struct {
+    vector2d_t pos;
+    int radius;   // the light reaches radius steps, 0 if the source was removed
+    int intensity;// the amount of light at the source, falls off linearly with the steps
+    int* cells;   // the row-major indices of the lit cells
+    uint8_t* amounts;// the amount of light for each lit cell
+    int cell_count;
+    int cell_capacity;
+} light_source_t;
+
+/**
+ * @brief The accumulated light of all sources of a floor, one intensity per cell.
+ */
+typedef struct {
+    int width;
+    int height;
+    uint32_t* intensity;// the summed light of all sources, row-major like the tiles
+    light_source_t* sources;
+    int source_count;   // the number of used entries of sources, removed sources included
+    int source_capacity;
+    uint64_t version;   // changes whenever the intensity of a cell changes
+} light_map_t;
+
+/**
+ * @brief Get the light at the given coordinates of a light_map_t, clamped to MAX_LIGHT_INTENSITY.
+ */
+#define LIGHT_AT(lights, x, y)                                                        \
+    ((lights)->intensity[(y) * (lights)->width + (x)] > MAX_LIGHT_INTENSITY           \
+             ? MAX_LIGHT_INTENSITY                                                    \
+             : (int) (lights)->intensity[(y) * (lights)->width + (x)])
+
+/**
+ * @brief Allocates an empty light map for floors of the given size.
+ *
+ * @param width The width of the floors to light
+ * @param height The height of the floors to light
+ * @return The pointer to the new light map, or NULL if the allocation failed.
+ * The light map must be freed with free_light_map().
+ */
+light_map_t* init_light_map(int width, int height);
+
+/**
+ * @brief Frees the given light map and all its sources.
+ *
+ * @param lights The light map to free, NULL is ignored.
+ */
+void free_light_map(light_map_t* lights);
+
+/**
+ * @brief Removes all sources and all light from the light map.
+ *
+ * @param lights The light map to clear
+ */
+void clear_light_map(light_map_t* lights);
+
+/**
+ * @brief Places a new light source and adds its light to the light map.
+ *
+ * The light is cast with the same shadowcasting as the light of the player, so walls block it.
+ * The cost grows with radius^2 and the light is kept until the source is moved or removed, or a
+ * tile in its reach changes (see update_light_area).
+ *
+ * @param lights The light map to add the source to
+ * @param map The map the light is cast on, must have the same size as the light map
+ * @param pos The position of the source
+ * @param radius The number of steps the light reaches, must be positive
+ * @param intensity The amount of light at the source, 1 to MAX_LIGHT_INTENSITY
+ * @return The id of the new source, NO_LIGHT_SOURCE if the arguments are invalid or the allocation failed
+ */
+int add_light_source(light_map_t* lights, const map_t* map, vector2d_t pos, int radius, int intensity);
+
+/**
+ * @brief Moves a light source and casts its light again, the other sources are not touched.
+ *
+ * @param lights The light map of the source
+ * @param map The map the light is cast on
+ * @param id The id of the source
+ * @param pos The new position of the source
+ * @return COMMON_SUCCESS on success, a non-zero value if the id or position is invalid or the allocation failed
+ */
+int move_light_source(light_map_t* lights, const map_t* map, int id, vector2d_t pos);
+
+/**
+ * @brief Takes the light of a source out of the light map, the ids of the other sources stay valid.
+ *
+ * @param lights The light map of the source
+ * @param id The id of the source
+ */
+void remove_light_source(light_map_t* lights, int id);
+
+/**
+ * @brief Casts the light of every source again whose reach overlaps the given area of changed tiles.
+ *
+ * The other sources keep their cached light, so a change of a few tiles costs only the sources
+ * around it and not the number of sources of the whole floor. The area is inclusive and may
+ * exceed the map.
+ *
+ * @param lights The light map to update
+ * @param map The changed map
+ * @param x_min The left edge of the changed area
+ * @param y_min The top edge of the changed area
+ * @param x_max The right edge of the changed area
+ * @param y_max The bottom edge of the changed area
+ * @return The number of sources whose light was cast again, -1 if the light of a source could not be
+ * cached completely (the other sources are still updated)
+ */
+int update_light_area(light_map_t* lights, const map_t* map, int x_min, int y_min, int x_max, int y_max);
+
+#endif//LIGHT_MAP_H
@@ -0,0 +1,239 @@
+/**
+ * @file floor_pipeline.c
+ * @brief Implements the background generation of the next floor.
+ */
+#include "floor_pipeline.h"
+
+#include "../logging/logger.h"
+#include "../thread/thread_handler.h"
+#include "map_generator.h"
+
+#include <stdbool.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+
+typedef CRITICAL_SECTION mutex_t;
+typedef CONDITION_VARIABLE cond_t;
+
+    #define INIT_MUTEX(mutex) InitializeCriticalSection(mutex)
+    #define INIT_COND(cond) InitializeConditionVariable(cond)
+    #define DESTROY_MUTEX(mutex) DeleteCriticalSection(mutex)
+    #define DESTROY_COND(cond)
+
+    #define MUTEX_LOCK(mutex) EnterCriticalSection(mutex)
+    #define MUTEX_UNLOCK(mutex) LeaveCriticalSection(mutex)
+    #define SIGNAL_ALL(cond) WakeAllConditionVariable(cond)
+    #define SIGNAL_WAIT(cond, mutex) SleepConditionVariableCS(cond, mutex, INFINITE)
+#else
+    #include <pthread.h>
+
+typedef pthread_mutex_t mutex_t;
+typedef pthread_cond_t cond_t;
+
+    #define INIT_MUTEX(mutex) pthread_mutex_init(mutex, NULL)
+    #define INIT_COND(cond) pthread_cond_init(cond, NULL)
+    #define DESTROY_MUTEX(mutex) pthread_mutex_destroy(mutex)
+    #define DESTROY_COND(cond) pthread_cond_destroy(cond)
+
+    #define MUTEX_LOCK(mutex) pthread_mutex_lock(mutex)
+    #define MUTEX_UNLOCK(mutex) pthread_mutex_unlock(mutex)
+    #define SIGNAL_ALL(cond) pthread_cond_broadcast(cond)
+    #define SIGNAL_WAIT(cond, mutex) pthread_cond_wait(cond, mutex)
+#endif
+
+typedef enum {
+    PIPELINE_IDLE,   // the spare map is free (or NULL)
+    PIPELINE_PENDING,// the worker generates into the spare map
+    PIPELINE_READY,  // the spare map holds the requested floor
+    PIPELINE_FAILED  // the generation of the requested floor failed
+} pipeline_state_t;
+
+typedef struct {
+    mutex_t mutex;
+    cond_t cond;// signaled on every state change
+
+    bool running;      // cleared to stop the worker
+    bool worker_active;// set while the worker thread runs
+    pipeline_state_t state;
+
+    map_t* spare;            // the prepared floor or a buffer for the next one
+    int previous_edge;       // exit edge of the floor before the requested floor
+    vector2d_t previous_exit;// exit of the floor before the requested floor
+    int floor;               // the number of the requested floor
+    uint64_t seed;           // the seed of the requested floor
+} floor_pipeline_t;
+
+static floor_pipeline_t pipeline;
+static bool pipeline_initialized = false;
+
+/**
+ * @brief The worker thread, generates the requested floor whenever one is pending.
+ */
+void floor_worker_thread(void) {
+    MUTEX_LOCK(&pipeline.mutex);
+    while (pipeline.running) {
+        if (pipeline.state != PIPELINE_PENDING) {
+            SIGNAL_WAIT(&pipeline.cond, &pipeline.mutex);
+            continue;
+        }
+        // the spare map belongs to the worker until the state changes
+        map_t* map = pipeline.spare;
+        map_t previous = {0};
+        previous.exit_edge = pipeline.previous_edge;
+        previous.exit = pipeline.previous_exit;
+        const uint64_t seed = pipeline.seed;
+        const floor_layout_t layout = get_floor_layout(pipeline.floor);
+        MUTEX_UNLOCK(&pipeline.mutex);
+
+        const int result = generate_map(map, &previous, seed, layout);
+
+        MUTEX_LOCK(&pipeline.mutex);
+        pipeline.state = result == COMMON_SUCCESS ? PIPELINE_READY : PIPELINE_FAILED;
+        SIGNAL_ALL(&pipeline.cond);
+    }
+    pipeline.worker_active = false;
+    SIGNAL_ALL(&pipeline.cond);
+    MUTEX_UNLOCK(&pipeline.mutex);
+}
+
+/**
+ * @brief Waits until the worker is not generating a floor. The mutex must be locked.
+ */
+void wait_for_worker(void) {
+    while (pipeline.state == PIPELINE_PENDING) {
+        SIGNAL_WAIT(&pipeline.cond, &pipeline.mutex);
+    }
+}
+
+int init_floor_pipeline(void) {
+    if (pipeline_initialized) return COMMON_SUCCESS;
+
+    INIT_MUTEX(&pipeline.mutex);
+    INIT_COND(&pipeline.cond);
+    pipeline.running = true;
+    pipeline.worker_active = true;
+    pipeline.state = PIPELINE_IDLE;
+    pipeline.spare = NULL;
+
+    if (start_simple_thread(floor_worker_thread) != 0) {
+        log_msg(ERROR, "floor_pipeline", "Failed to start the worker thread");
+        DESTROY_COND(&pipeline.cond);
+        DESTROY_MUTEX(&pipeline.mutex);
+        return 1;
+    }
+    pipeline_initialized = true;
+    return COMMON_SUCCESS;
+}
+
+void prepare_next_floor(const map_t* current_floor, const int floor, const uint64_t seed) {
+    if (!pipeline_initialized) return;
+
+    int width;
+    int height;
+    get_floor_dimensions(floor, &width, &height);
+
+    MUTEX_LOCK(&pipeline.mutex);
+    wait_for_worker();
+    if (pipeline.spare != NULL && (pipeline.spare->width != width || pipeline.spare->height != height)) {
+        free_map(pipeline.spare);
+        pipeline.spare = NULL;
+    }
+    if (pipeline.spare == NULL) {
+        pipeline.spare = init_map(width, height);
+    }
+    if (pipeline.spare == NULL) {
+        pipeline.state = PIPELINE_IDLE;
+        MUTEX_UNLOCK(&pipeline.mutex);
+        log_msg(WARNING, "floor_pipeline", "Failed to allocate floor %d, it is generated on demand", floor);
+        return;
+    }
+
+    pipeline.previous_edge = current_floor != NULL ? current_floor->exit_edge : NO_EDGE;
+    pipeline.previous_exit = current_floor != NULL ? current_floor->exit : (vector2d_t) {0, 0};
+    pipeline.floor = floor;
+    pipeline.seed = seed;
+    pipeline.state = PIPELINE_PENDING;
+    SIGNAL_ALL(&pipeline.cond);
+    MUTEX_UNLOCK(&pipeline.mutex);
+}
+
+map_t* take_floor(const map_t* previous_floor, const int floor, const uint64_t seed) {
+    int width;
+    int height;
+    get_floor_dimensions(floor, &width, &height);
+
+    map_t* map = NULL;
+    if (pipeline_initialized) {
+        const int previous_edge = previous_floor != NULL ? previous_floor->exit_edge : NO_EDGE;
+        const vector2d_t previous_exit = previous_floor != NULL ? previous_floor->exit : (vector2d_t) {0, 0};
+
+        MUTEX_LOCK(&pipeline.mutex);
+        wait_for_worker();
+        const bool matches = pipeline.floor == floor && pipeline.seed == seed && pipeline.previous_edge == previous_edge &&
+                             (previous_edge == NO_EDGE || (pipeline.previous_exit.dx == previous_exit.dx && pipeline.previous_exit.dy == previous_exit.dy));
+        if (pipeline.state == PIPELINE_READY && matches) {
+            map = pipeline.spare;
+            pipeline.spare = NULL;
+            pipeline.state = PIPELINE_IDLE;
+            MUTEX_UNLOCK(&pipeline.mutex);
+            return map;
+        }
+        // the prepared floor is not the requested one, reuse its memory if possible
+        if (pipeline.spare != NULL && pipeline.spare->width == width && pipeline.spare->height == height) {
+            map = pipeline.spare;
+            pipeline.spare = NULL;
+        }
+        pipeline.state = PIPELINE_IDLE;
+        MUTEX_UNLOCK(&pipeline.mutex);
+    }
+
+    if (map == NULL) {
+        map = init_map(width, height);
+        NULL_PTR_HANDLER_RETURN(map, NULL, "floor_pipeline", "Failed to allocate floor %d", floor);
+    }
+    if (generate_map(map, previous_floor, seed, get_floor_layout(floor)) != COMMON_SUCCESS) {
+        log_msg(ERROR, "floor_pipeline", "Failed to generate floor %d", floor);
+        free_map(map);
+        return NULL;
+    }
+    return map;
+}
+
+void release_floor(map_t* map) {
+    if (map == NULL) return;
+    if (!pipeline_initialized) {
+        free_map(map);
+        return;
+    }
+
+    MUTEX_LOCK(&pipeline.mutex);
+    if (pipeline.spare == NULL && pipeline.state != PIPELINE_PENDING) {
+        pipeline.spare = map;
+        pipeline.state = PIPELINE_IDLE;
+        map = NULL;
+    }
+    MUTEX_UNLOCK(&pipeline.mutex);
+    // the pipeline already has a spare map
+    free_map(map);
+}
+
+void shutdown_floor_pipeline(void) {
+    if (!pipeline_initialized) return;
+
+    MUTEX_LOCK(&pipeline.mutex);
+    pipeline.running = false;
+    SIGNAL_ALL(&pipeline.cond);
+    // the worker finishes the current floor before it stops
+    while (pipeline.worker_active) {
+        SIGNAL_WAIT(&pipeline.cond, &pipeline.mutex);
+    }
+    free_map(pipeline.spare);
+    pipeline.spare = NULL;
+    pipeline.state = PIPELINE_IDLE;
+    MUTEX_UNLOCK(&pipeline.mutex);
+
+    DESTROY_COND(&pipeline.cond);
+    DESTROY_MUTEX(&pipeline.mutex);
+    pipeline_initialized = false;
+}
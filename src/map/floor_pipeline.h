@@ -0,0 +1,61 @@
+/**
+ * @file floor_pipeline.h
+ * @brief Exposes functions for generating the next floor in the background.
+ *
+ * While the player explores a floor, a worker thread already generates the next floor into a
+ * spare map. Taking the exit then only swaps the current map with the prepared one.
+ */
+#ifndef FLOOR_PIPELINE_H
+#define FLOOR_PIPELINE_H
+
+#include "map.h"
+
+#include <stdint.h>
+
+/**
+ * @brief Initializes the floor pipeline and starts its worker thread.
+ *
+ * @return COMMON_SUCCESS on success, a non-zero value otherwise
+ */
+int init_floor_pipeline(void);
+
+/**
+ * @brief Starts generating the given floor in the background.
+ *
+ * Waits for a previous request to finish first. The exit of the current floor is copied, so
+ * the current floor can still be changed while the next floor is generated.
+ *
+ * @param current_floor The floor the player is on, its exit becomes the start of the next floor
+ * @param floor The number of the floor to generate
+ * @param seed The seed of the floor to generate
+ */
+void prepare_next_floor(const map_t* current_floor, int floor, uint64_t seed);
+
+/**
+ * @brief Returns the generated floor.
+ *
+ * If the prepared floor matches the given floor number, seed and previous floor it is returned
+ * without any further work (waiting for the worker if it is not done yet). Otherwise the floor
+ * is generated on the calling thread.
+ *
+ * @param previous_floor The floor before the requested floor, may be NULL
+ * @param floor The number of the requested floor
+ * @param seed The seed of the requested floor
+ * @return The generated floor or NULL on failure. The caller owns the map and should hand it
+ * back with release_floor() when it is no longer needed.
+ */
+map_t* take_floor(const map_t* previous_floor, int floor, uint64_t seed);
+
+/**
+ * @brief Hands a map back to the pipeline, it is reused for the next floor if possible.
+ *
+ * @param map The map which is no longer needed, NULL is ignored
+ */
+void release_floor(map_t* map);
+
+/**
+ * @brief Stops the worker thread and frees the spare map.
+ */
+void shutdown_floor_pipeline(void);
+
+#endif//FLOOR_PIPELINE_H
@@ -0,0 +1,205 @@
+/**
+ * @file cave_layout.c
+ * @brief Implements the cave floor layout (cellular automata on bit packed rows).
+ */
+#include "cave_layout.h"
+
+#include "../../logging/logger.h"
+#include "../map_regions.h"
+
+#include <stdlib.h>
+
+#define ALL_WALLS (~0ULL)
+
+/**
+ * @brief Marks the border of the given row and the unused bits of its last word as walls.
+ * @param row the row to mark
+ * @param y the y coordinate of the row
+ * @param width the width of the cave
+ * @param height the height of the cave
+ */
+void mark_cave_border(uint64_t* row, const int y, const int width, const int height) {
+    const int words = cave_row_words(width);
+    if (y == 0 || y == height - 1) {
+        for (int k = 0; k < words; k++) {
+            row[k] = ALL_WALLS;
+        }
+        return;
+    }
+    row[0] |= 1ULL;
+    row[(width - 1) / 64] |= 1ULL << ((width - 1) % 64);
+    if (width % 64 != 0) {
+        row[words - 1] |= ALL_WALLS << (width % 64);
+    }
+}
+
+int cave_row_words(const int width) {
+    return (width + 63) / 64;
+}
+
+void smooth_cave(const uint64_t* current, uint64_t* next, const int width, const int height) {
+    const int words = cave_row_words(width);
+
+    mark_cave_border(next, 0, width, height);
+    mark_cave_border(next + (size_t) (height - 1) * words, height - 1, width, height);
+    for (int y = 1; y < height - 1; y++) {
+        const uint64_t* rows[3] = {current + (size_t) (y - 1) * words, current + (size_t) y * words, current + (size_t) (y + 1) * words};
+        uint64_t* out = next + (size_t) y * words;
+
+        for (int k = 0; k < words; k++) {
+            // the 9 cells of the neighbourhood for 64 cells at once, outside of the cave counts as wall
+            uint64_t n[9];
+            for (int r = 0; r < 3; r++) {
+                const uint64_t center = rows[r][k];
+                const uint64_t before = k > 0 ? rows[r][k - 1] : ALL_WALLS;
+                const uint64_t after = k < words - 1 ? rows[r][k + 1] : ALL_WALLS;
+                n[r * 3] = (center << 1) | (before >> 63);// the cell to the left
+                n[r * 3 + 1] = center;
+                n[r * 3 + 2] = (center >> 1) | (after << 63);// the cell to the right
+            }
+
+            // add the 9 bits per cell with full adders, the count ends up in ones, twos, fours and eights
+            const uint64_t sum_a = n[0] ^ n[1] ^ n[2];
+            const uint64_t carry_a = (n[0] & n[1]) | (n[2] & (n[0] ^ n[1]));
+            const uint64_t sum_b = n[3] ^ n[4] ^ n[5];
+            const uint64_t carry_b = (n[3] & n[4]) | (n[5] & (n[3] ^ n[4]));
+            const uint64_t sum_c = n[6] ^ n[7] ^ n[8];
+            const uint64_t carry_c = (n[6] & n[7]) | (n[8] & (n[6] ^ n[7]));
+
+            const uint64_t ones = sum_a ^ sum_b ^ sum_c;
+            const uint64_t carry_d = (sum_a & sum_b) | (sum_c & (sum_a ^ sum_b));
+
+            const uint64_t twos_partial = carry_a ^ carry_b ^ carry_c;
+            const uint64_t fours_a = (carry_a & carry_b) | (carry_c & (carry_a ^ carry_b));
+            const uint64_t twos = twos_partial ^ carry_d;
+            const uint64_t fours_b = twos_partial & carry_d;
+
+            const uint64_t fours = fours_a ^ fours_b;
+            const uint64_t eights = fours_a & fours_b;
+
+            // count >= 5 (CAVE_WALL_THRESHOLD): 8 or more, or 4 plus at least 1
+            out[k] = eights | (fours & (twos | ones));
+        }
+        mark_cave_border(out, y, width, height);
+    }
+}
+
+/**
+ * @brief Fills the cave with random walls (about 44 percent).
+ * @param cave the bit packed cave to fill
+ * @param rng the random number generator to use
+ * @param width the width of the cave
+ * @param height the height of the cave
+ */
+void fill_cave_randomly(uint64_t* cave, rng_t* rng, const int width, const int height) {
+    const int words = cave_row_words(width);
+    for (int y = 0; y < height; y++) {
+        uint64_t* row = cave + (size_t) y * words;
+        for (int k = 0; k < words; k++) {
+            const uint64_t a = rng_next(rng);
+            const uint64_t b = rng_next(rng);
+            const uint64_t c = rng_next(rng);
+            const uint64_t d = rng_next(rng);
+            // every bit is set with a probability of 1 - (3/4)^2 = 7/16
+            row[k] = (a & b) | (c & d);
+        }
+        mark_cave_border(row, y, width, height);
+    }
+}
+
+/**
+ * @brief Finds all caves with the region index, fills the small ones and connects the others with tunnels.
+ * @param map the map with the carved caves
+ * @return COMMON_SUCCESS on success, a non-zero value if the region index could not be built
+ */
+int connect_caves(map_t* map) {
+    region_index_t* regions = init_region_index(map->width, map->height);
+    NULL_PTR_HANDLER_RETURN(regions, 1, "cave_layout", "Failed to allocate the region index");
+    uint8_t* connected = NULL;
+    if (build_region_index(regions, map) == COMMON_SUCCESS) {
+        connected = calloc((size_t) regions->region_count + 1, sizeof(uint8_t));
+    }
+    if (connected == NULL) {
+        log_msg(ERROR, "cave_layout", "Failed to find the caves of a %d x %d floor", map->width, map->height);
+        free_region_index(regions);
+        return 1;
+    }
+
+    // fill the small caves first, the tunnels only turn walls into floors and never cut through a kept cave
+    const int cells = map->width * map->height;
+    for (int cell = 0; cell < cells; cell++) {
+        const int region = regions->labels[cell];
+        if (region != NO_REGION && regions->sizes[region] < CAVE_MIN_REGION_SIZE && map->tiles[cell] == FLOOR) {
+            map->tiles[cell] = WALL;
+        }
+    }
+
+    int has_cave = 0;
+    vector2d_t previous_cave = {0, 0};
+    vector2d_t nearest_cave = {map->width / 2, map->height / 2};
+    int nearest_distance = map->width + map->height;
+
+    for (int y = 1; y < map->height - 1; y++) {
+        for (int x = 1; x < map->width - 1; x++) {
+            const int region = REGION_AT(regions, x, y);
+            if (region == NO_REGION || regions->sizes[region] < CAVE_MIN_REGION_SIZE || connected[region]) continue;
+            connected[region] = 1;
+
+            const vector2d_t cave = {x, y};
+            if (has_cave) {
+                // caves are found in scan order, so the previous cave is usually close by
+                carve_corridor(map, previous_cave, cave);
+            }
+            has_cave = 1;
+            previous_cave = cave;
+
+            const int distance = abs(x - map->start.dx) + abs(y - map->start.dy);
+            if (distance < nearest_distance) {
+                nearest_distance = distance;
+                nearest_cave = cave;
+            }
+        }
+    }
+
+    free(connected);
+    free_region_index(regions);
+    // without any cave the tunnel to the center is the whole floor
+    carve_corridor(map, map->start, nearest_cave);
+    return COMMON_SUCCESS;
+}
+
+int generate_cave_layout(map_t* map, rng_t* rng) {
+    NULL_PTR_HANDLER_RETURN(map, 1, "cave_layout", "In generate_cave_layout given map is NULL");
+
+    const int words = cave_row_words(map->width);
+    const size_t size = (size_t) words * (size_t) map->height;
+    uint64_t* current = malloc(size * sizeof(uint64_t));
+    uint64_t* next = malloc(size * sizeof(uint64_t));
+    if (current == NULL || next == NULL) {
+        log_msg(ERROR, "cave_layout", "Failed to allocate the cave for a %d x %d floor", map->width, map->height);
+        free(current);
+        free(next);
+        return 1;
+    }
+
+    fill_cave_randomly(current, rng, map->width, map->height);
+    for (int step = 0; step < CAVE_SMOOTHING_STEPS; step++) {
+        smooth_cave(current, next, map->width, map->height);
+        uint64_t* swap = current;
+        current = next;
+        next = swap;
+    }
+
+    // copy the inner cells to the map, the border keeps its walls and doors
+    for (int y = 1; y < map->height - 1; y++) {
+        const uint64_t* row = current + (size_t) y * words;
+        map_tile_t* tiles = &MAP_TILE(map, 0, y);
+        for (int x = 1; x < map->width - 1; x++) {
+            tiles[x] = (row[x / 64] >> (x % 64)) & 1ULL ? WALL : FLOOR;
+        }
+    }
+    free(current);
+    free(next);
+
+    return connect_caves(map);
+}
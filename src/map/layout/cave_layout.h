@@ -0,0 +1,53 @@
+/**
+ * @file cave_layout.h
+ * @brief Exposes the cave floor layout (cellular automata).
+ */
+#ifndef CAVE_LAYOUT_H
+#define CAVE_LAYOUT_H
+
+#include "../../random/rng.h"
+#include "../map.h"
+
+#include <stdint.h>
+
+#define CAVE_SMOOTHING_STEPS 4 // how often the cellular automata rule is applied
+#define CAVE_WALL_THRESHOLD 5  // a cell becomes a wall if at least this many of the 3x3 cells are walls
+#define CAVE_MIN_REGION_SIZE 16// smaller caves are filled instead of connected
+
+/**
+ * @brief Returns the number of 64 bit words one row of a bit packed cave needs.
+ *
+ * @param width The width of the cave
+ * @return The number of words per row
+ */
+int cave_row_words(int width);
+
+/**
+ * @brief Applies one step of the cellular automata rule to a bit packed cave.
+ *
+ * Every row is stored in cave_row_words(width) words, bit x % 64 of word x / 64 is the cell x
+ * and a set bit is a wall. A cell becomes a wall if at least CAVE_WALL_THRESHOLD cells of its
+ * 3x3 neighbourhood (including itself) are walls. The neighbours of 64 cells are counted at once
+ * with bitwise adders, cells outside of the cave count as walls and the border stays a wall.
+ *
+ * @param current The cave before the step
+ * @param next Receives the cave after the step, must not overlap current
+ * @param width The width of the cave
+ * @param height The height of the cave
+ */
+void smooth_cave(const uint64_t* current, uint64_t* next, int width, int height);
+
+/**
+ * @brief Carves a cave into the map.
+ *
+ * The map is filled with random walls and smoothed with a cellular automata. Afterwards small
+ * caves are filled, all other caves are connected with tunnels and the start position of the map
+ * is connected to the nearest cave.
+ *
+ * @param map The map to carve into, must only contain walls and the start door
+ * @param rng The random number generator to use
+ * @return COMMON_SUCCESS on success, a non-zero value otherwise
+ */
+int generate_cave_layout(map_t* map, rng_t* rng);
+
+#endif//CAVE_LAYOUT_H
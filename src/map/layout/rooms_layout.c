@@ -0,0 +1,88 @@
+/**
+ * @file rooms_layout.c
+ * @brief Implements the room based floor layout (binary space partitioning).
+ */
+#include "rooms_layout.h"
+
+typedef struct {
+    int x;
+    int y;
+    int width;
+    int height;
+} bsp_area_t;
+
+/**
+ * @brief Carves a room of random size and position into the area, keeping a wall around it.
+ * @param map the map to carve into
+ * @param rng the random number generator to use
+ * @param area the area of the room
+ * @return a random cell of the room
+ */
+vector2d_t carve_room(map_t* map, rng_t* rng, const bsp_area_t area) {
+    // the area without the surrounding wall
+    const int max_width = area.width - 2;
+    const int max_height = area.height - 2;
+    const int width = max_width > BSP_MIN_ROOM_SIZE ? BSP_MIN_ROOM_SIZE + rng_range(rng, max_width - BSP_MIN_ROOM_SIZE + 1) : max_width;
+    const int height = max_height > BSP_MIN_ROOM_SIZE ? BSP_MIN_ROOM_SIZE + rng_range(rng, max_height - BSP_MIN_ROOM_SIZE + 1) : max_height;
+    const int room_x = area.x + 1 + rng_range(rng, max_width - width + 1);
+    const int room_y = area.y + 1 + rng_range(rng, max_height - height + 1);
+
+    for (int y = room_y; y < room_y + height; y++) {
+        for (int x = room_x; x < room_x + width; x++) {
+            MAP_TILE(map, x, y) = FLOOR;
+        }
+    }
+    return (vector2d_t) {room_x + rng_range(rng, width), room_y + rng_range(rng, height)};
+}
+
+/**
+ * @brief Splits the area in two parts until it is too small, then carves a room into it.
+ *
+ * The recursion depth grows with the logarithm of the map size, so even the largest maps only
+ * need a few dozen stack frames.
+ *
+ * @param map the map to carve into
+ * @param rng the random number generator to use
+ * @param area the area to split
+ * @return a random cell of a room in this area
+ */
+vector2d_t split_area(map_t* map, rng_t* rng, const bsp_area_t area) {
+    const int can_split_vertical = area.width >= 2 * BSP_MIN_LEAF_SIZE;
+    const int can_split_horizontal = area.height >= 2 * BSP_MIN_LEAF_SIZE;
+    if (!can_split_vertical && !can_split_horizontal) {
+        return carve_room(map, rng, area);
+    }
+
+    // prefer to split the longer side, so the rooms do not get too narrow
+    int vertical = can_split_vertical;
+    if (can_split_vertical && can_split_horizontal) {
+        vertical = area.width == area.height ? rng_range(rng, 2) : area.width > area.height;
+    }
+
+    bsp_area_t first = area;
+    bsp_area_t second = area;
+    if (vertical) {
+        first.width = BSP_MIN_LEAF_SIZE + rng_range(rng, area.width - 2 * BSP_MIN_LEAF_SIZE + 1);
+        second.x = area.x + first.width;
+        second.width = area.width - first.width;
+    } else {
+        first.height = BSP_MIN_LEAF_SIZE + rng_range(rng, area.height - 2 * BSP_MIN_LEAF_SIZE + 1);
+        second.y = area.y + first.height;
+        second.height = area.height - first.height;
+    }
+
+    const vector2d_t first_room = split_area(map, rng, first);
+    const vector2d_t second_room = split_area(map, rng, second);
+    carve_corridor(map, first_room, second_room);
+    return rng_range(rng, 2) ? first_room : second_room;
+}
+
+int generate_rooms_layout(map_t* map, rng_t* rng) {
+    NULL_PTR_HANDLER_RETURN(map, 1, "rooms_layout", "In generate_rooms_layout given map is NULL");
+
+    // the areas include the outer wall, the wall around every room keeps the border intact
+    const bsp_area_t whole_map = {0, 0, map->width, map->height};
+    const vector2d_t room = split_area(map, rng, whole_map);
+    carve_corridor(map, map->start, room);
+    return COMMON_SUCCESS;
+}
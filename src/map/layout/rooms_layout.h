@@ -0,0 +1,27 @@
+/**
+ * @file rooms_layout.h
+ * @brief Exposes the room based floor layout (binary space partitioning).
+ */
+#ifndef ROOMS_LAYOUT_H
+#define ROOMS_LAYOUT_H
+
+#include "../../random/rng.h"
+#include "../map.h"
+
+#define BSP_MIN_LEAF_SIZE 8// an area is only split if both parts keep at least this size
+#define BSP_MIN_ROOM_SIZE 3// the smallest room width and height
+
+/**
+ * @brief Carves rooms connected by corridors into the map.
+ *
+ * The map is split recursively into smaller areas, every area that cannot be split any further
+ * gets a room and the rooms of both halves of a split are connected with a corridor. Finally the
+ * start position of the map is connected to a room.
+ *
+ * @param map The map to carve into, must only contain walls and the start door
+ * @param rng The random number generator to use
+ * @return COMMON_SUCCESS on success, a non-zero value otherwise
+ */
+int generate_rooms_layout(map_t* map, rng_t* rng);
+
+#endif//ROOMS_LAYOUT_H
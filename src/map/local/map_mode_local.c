@@ -5,7 +5,7 @@
 
 #include <stdlib.h>
 
-char** map_mode_strings = NULL;
+const char** map_mode_strings = NULL;
 
 void update_map_mode_local(void);
 
@@ -23,12 +23,6 @@ int init_map_mode_local(void) {
 
 void shutdown_map_mode_local(void) {
     if (map_mode_strings != NULL) {
-        for (int i = 0; i < MAX_MAP_MODE_STRINGS; i++) {
-            if (map_mode_strings[i] != NULL) {
-                free(map_mode_strings[i]);
-                map_mode_strings[i] = NULL;
-            }
-        }
         free(map_mode_strings);
         map_mode_strings = NULL;
     }
@@ -36,14 +30,8 @@ void shutdown_map_mode_local(void) {
 
 void update_map_mode_local(void) {
     if (map_mode_strings == NULL) return;// module not initialized
-    for (int i = 0; i < MAX_MAP_MODE_STRINGS; i++) {
-        if (map_mode_strings[i] != NULL) {
-            free(map_mode_strings[i]);
-        }
-    }
-
-    map_mode_strings[PRESS_KEY_MENU] = get_local_string("MAP.PRESS.KEY.MENU");
-    map_mode_strings[PRESS_KEY_STATS] = get_local_string("MAP.PRESS.KEY.STATS");
-    map_mode_strings[PRESS_KEY_INVENTORY] = get_local_string("MAP.PRESS.KEY.INVENTORY");
-    map_mode_strings[PLAYER_POSITION_STR] = get_local_string("MAP.PLAYER.POSITION");
+    map_mode_strings[PRESS_KEY_MENU] = get_local_text_by_id(LOCAL_MAP_PRESS_KEY_MENU);
+    map_mode_strings[PRESS_KEY_STATS] = get_local_text_by_id(LOCAL_MAP_PRESS_KEY_STATS);
+    map_mode_strings[PRESS_KEY_INVENTORY] = get_local_text_by_id(LOCAL_MAP_PRESS_KEY_INVENTORY);
+    map_mode_strings[PLAYER_POSITION_STR] = get_local_text_by_id(LOCAL_MAP_PLAYER_POSITION);
 }
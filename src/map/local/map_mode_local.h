@@ -13,7 +13,7 @@ enum map_mode_index {
  * @var map_mode_strings
  * Global array of local strings used by the map mode.
  */
-extern char** map_mode_strings;
+extern const char** map_mode_strings;
 
 /**
  * @brief Initializes the local map mode.
@@ -4,8 +4,16 @@
  */
 #include "map.h"
 
-map_tile_t map[WIDTH][HEIGHT];
-map_tile_t revealed_map[WIDTH][HEIGHT];
+#include "../logging/logger.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+map_t* current_map = NULL;
+
+// the last version given to a map, maps are also generated on the floor pipeline thread
+atomic_uint_fast64_t last_map_version = 0;
 
 
 vector2d_t directions[4] = {
@@ -14,3 +22,225 @@ vector2d_t directions[4] = {
         {-1, 0},// left
         {1, 0}  // right
 };
+
+map_t* init_map(const int width, const int height) {
+    CHECK_ARG_RETURN(width < MIN_MAP_WIDTH || width > MAX_MAP_WIDTH || height < MIN_MAP_HEIGHT || height > MAX_MAP_HEIGHT,
+                     NULL, "Map", "Invalid map dimensions: %d x %d", width, height);
+    CHECK_ARG_RETURN(width % 2 == 0 || height % 2 == 0, NULL, "Map", "Map dimensions must be odd: %d x %d", width, height);
+
+    map_t* map = malloc(sizeof(map_t));
+    NULL_PTR_HANDLER_RETURN(map, NULL, "Map", "Failed to allocate memory for the map");
+
+    const size_t cells = (size_t) width * (size_t) height;
+    const int row_words = (width + 63) / 64;
+    const size_t layer_words = (size_t) row_words * (size_t) height;
+    // one block for the tiles and both bit layers, the bit layers start at the next word
+    const size_t tile_words = (cells * sizeof(map_tile_t) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    uint64_t* block = malloc((tile_words + 2 * layer_words) * sizeof(uint64_t));
+    if (block == NULL) {
+        log_msg(ERROR, "Map", "Failed to allocate memory for %d x %d tiles", width, height);
+        free(map);
+        return NULL;
+    }
+    map->tiles = (map_tile_t*) block;
+    map->seen = block + tile_words;
+    map->visible = map->seen + layer_words;
+    map->row_words = row_words;
+    map->width = width;
+    map->height = height;
+    map->start_edge = NO_EDGE;
+    map->start = (vector2d_t) {0, 0};
+    map->exit_edge = NO_EDGE;
+    map->exit = (vector2d_t) {0, 0};
+    mark_map_changed(map);
+
+    for (size_t i = 0; i < cells; i++) {
+        map->tiles[i] = WALL;
+    }
+    clear_revealed(map);
+    return map;
+}
+
+void mark_map_changed(map_t* map) {
+    NULL_PTR_HANDLER_RETURN(map, , "Map", "In mark_map_changed given map is NULL");
+    map->version = atomic_fetch_add(&last_map_version, 1) + 1;
+}
+
+void clear_revealed(map_t* map) {
+    NULL_PTR_HANDLER_RETURN(map, , "Map", "In clear_revealed given map is NULL");
+    // both layers follow each other
+    memset(map->seen, 0, 2 * (size_t) map->row_words * (size_t) map->height * sizeof(uint64_t));
+}
+
+/**
+ * @brief Clips the area to the map and converts the columns to word indices.
+ * @param map the map to clip to
+ * @param x_min the first column, set to the first word
+ * @param y_min the first row, clipped
+ * @param x_max the last column, set to the last word
+ * @param y_max the last row, clipped
+ * @return 1 if the clipped area is not empty, 0 otherwise
+ */
+int clip_to_words(const map_t* map, int* x_min, int* y_min, int* x_max, int* y_max) {
+    if (*x_min < 0) *x_min = 0;
+    if (*y_min < 0) *y_min = 0;
+    if (*x_max > map->width - 1) *x_max = map->width - 1;
+    if (*y_max > map->height - 1) *y_max = map->height - 1;
+    if (*x_min > *x_max || *y_min > *y_max) return 0;
+    *x_min /= 64;
+    *x_max /= 64;
+    return 1;
+}
+
+void clear_visible_area(map_t* map, int x_min, int y_min, int x_max, int y_max) {
+    NULL_PTR_HANDLER_RETURN(map, , "Map", "In clear_visible_area given map is NULL");
+    if (!clip_to_words(map, &x_min, &y_min, &x_max, &y_max)) return;
+
+    // whole words are cleared, the light of a map is always cleared and drawn again as a whole
+    for (int y = y_min; y <= y_max; y++) {
+        uint64_t* row = map->visible + (size_t) y * map->row_words;
+        memset(row + x_min, 0, (size_t) (x_max - x_min + 1) * sizeof(uint64_t));
+    }
+}
+
+void merge_visible_area(map_t* map, int x_min, int y_min, int x_max, int y_max) {
+    NULL_PTR_HANDLER_RETURN(map, , "Map", "In merge_visible_area given map is NULL");
+    if (!clip_to_words(map, &x_min, &y_min, &x_max, &y_max)) return;
+
+    for (int y = y_min; y <= y_max; y++) {
+        uint64_t* seen = map->seen + (size_t) y * map->row_words;
+        const uint64_t* visible = map->visible + (size_t) y * map->row_words;
+        for (int k = x_min; k <= x_max; k++) {
+            seen[k] |= visible[k];
+        }
+    }
+}
+
+map_tile_t* export_save_tiles(const map_t* map) {
+    NULL_PTR_HANDLER_RETURN(map, NULL, "Map", "In export_save_tiles given map is NULL");
+    map_tile_t* tiles = malloc((size_t) map->width * (size_t) map->height * sizeof(map_tile_t));
+    NULL_PTR_HANDLER_RETURN(tiles, NULL, "Map", "Failed to allocate the save tiles of a %d x %d floor", map->width, map->height);
+
+    for (int y = 0; y < map->height; y++) {
+        for (int x = 0; x < map->width; x++) {
+            tiles[SAVE_TILE_INDEX(map, x, y)] = MAP_TILE(map, x, y);
+        }
+    }
+    return tiles;
+}
+
+void import_save_tiles(map_t* map, const map_tile_t* tiles) {
+    NULL_PTR_HANDLER_RETURN(map, , "Map", "In import_save_tiles given map is NULL");
+    NULL_PTR_HANDLER_RETURN(tiles, , "Map", "In import_save_tiles given tiles are NULL");
+
+    for (int y = 0; y < map->height; y++) {
+        for (int x = 0; x < map->width; x++) {
+            MAP_TILE(map, x, y) = tiles[SAVE_TILE_INDEX(map, x, y)];
+        }
+    }
+    mark_map_changed(map);
+}
+
+map_tile_t* export_revealed_tiles(const map_t* map) {
+    NULL_PTR_HANDLER_RETURN(map, NULL, "Map", "In export_revealed_tiles given map is NULL");
+    map_tile_t* revealed = malloc((size_t) map->width * (size_t) map->height * sizeof(map_tile_t));
+    NULL_PTR_HANDLER_RETURN(revealed, NULL, "Map", "Failed to allocate the revealed tiles of a %d x %d floor", map->width, map->height);
+
+    for (int y = 0; y < map->height; y++) {
+        for (int x = 0; x < map->width; x++) {
+            revealed[SAVE_TILE_INDEX(map, x, y)] = MAP_REVEALED(map, x, y);
+        }
+    }
+    return revealed;
+}
+
+void import_revealed_tiles(map_t* map, const map_tile_t* revealed) {
+    NULL_PTR_HANDLER_RETURN(map, , "Map", "In import_revealed_tiles given map is NULL");
+    NULL_PTR_HANDLER_RETURN(revealed, , "Map", "In import_revealed_tiles given revealed tiles are NULL");
+
+    clear_revealed(map);
+    for (int y = 0; y < map->height; y++) {
+        for (int x = 0; x < map->width; x++) {
+            if (revealed[SAVE_TILE_INDEX(map, x, y)] != HIDDEN) MAP_REVEAL(map, x, y);
+        }
+    }
+}
+
+void free_map(map_t* map) {
+    if (map == NULL) return;
+
+    free(map->tiles);
+    free(map);
+}
+
+int resize_current_map(const int width, const int height) {
+    if (current_map != NULL && current_map->width == width && current_map->height == height) {
+        return COMMON_SUCCESS;
+    }
+
+    map_t* new_map = init_map(width, height);
+    NULL_PTR_HANDLER_RETURN(new_map, 1, "Map", "Failed to resize the current map to %d x %d", width, height);
+
+    free_map(current_map);
+    current_map = new_map;
+    return COMMON_SUCCESS;
+}
+
+void replace_current_map(map_t* map) {
+    if (map == current_map) return;
+
+    free_map(current_map);
+    current_map = map;
+}
+
+int locate_exit(map_t* map) {
+    NULL_PTR_HANDLER_RETURN(map, 0, "Map", "In locate_exit given map is NULL");
+
+    map->exit_edge = NO_EDGE;
+    for (int x = 0; x < map->width; x++) {
+        if (MAP_TILE(map, x, 0) == EXIT_DOOR) {
+            map->exit_edge = TOP;
+            map->exit = (vector2d_t) {x, 0};
+        } else if (MAP_TILE(map, x, map->height - 1) == EXIT_DOOR) {
+            map->exit_edge = BOTTOM;
+            map->exit = (vector2d_t) {x, map->height - 1};
+        }
+    }
+    for (int y = 0; y < map->height; y++) {
+        if (MAP_TILE(map, 0, y) == EXIT_DOOR) {
+            map->exit_edge = LEFT;
+            map->exit = (vector2d_t) {0, y};
+        } else if (MAP_TILE(map, map->width - 1, y) == EXIT_DOOR) {
+            map->exit_edge = RIGHT;
+            map->exit = (vector2d_t) {map->width - 1, y};
+        }
+    }
+    return map->exit_edge != NO_EDGE;
+}
+
+/**
+ * @brief Turns the given cell into a floor, if it is an inner wall.
+ * @param map the map to carve into
+ * @param x the x coordinate of the cell
+ * @param y the y coordinate of the cell
+ */
+void carve_cell(map_t* map, const int x, const int y) {
+    if (x < 1 || x > map->width - 2 || y < 1 || y > map->height - 2) return;
+    if (MAP_TILE(map, x, y) == WALL) {
+        MAP_TILE(map, x, y) = FLOOR;
+    }
+}
+
+void carve_corridor(map_t* map, const vector2d_t from, const vector2d_t to) {
+    NULL_PTR_HANDLER_RETURN(map, , "Map", "In carve_corridor given map is NULL");
+
+    const int step_x = to.dx > from.dx ? 1 : -1;
+    for (int x = from.dx; x != to.dx; x += step_x) {
+        carve_cell(map, x, from.dy);
+    }
+    const int step_y = to.dy > from.dy ? 1 : -1;
+    for (int y = from.dy; y != to.dy; y += step_y) {
+        carve_cell(map, to.dx, y);
+    }
+    carve_cell(map, to.dx, to.dy);
+}
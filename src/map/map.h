@@ -5,8 +5,12 @@
 #ifndef MAP_H
 #define MAP_H
 
-#define WIDTH 39 // must be odd
-#define HEIGHT 19// must be odd
+#define DEFAULT_MAP_WIDTH 39 // must be odd
+#define DEFAULT_MAP_HEIGHT 19// must be odd
+#define MIN_MAP_WIDTH 9      // smallest floor the generator can work with
+#define MIN_MAP_HEIGHT 9
+#define MAX_MAP_WIDTH 8191// upper limit for a single floor
+#define MAX_MAP_HEIGHT 8191
 
 #define ENEMY_COUNT 8
 #define ENEMY_MIN_DISTANCE 3
@@ -15,9 +19,12 @@
 #define BOTTOM 1
 #define LEFT 2
 #define RIGHT 3
+#define NO_EDGE (-1)
 
 #include "../common.h"
 
+#include <stdint.h>
+
 typedef enum {
     WALL = 0,
     FLOOR = 1,
@@ -30,10 +37,189 @@ typedef enum {
     HIDDEN = 99
 } map_tile_t;
 
+/**
+ * @brief A single floor of the dungeon with its size only known at runtime.
+ *
+ * The tiles and both bit layers are stored in one contiguous heap block. The tiles are laid out
+ * row-major (index = y * width + x). The bit layers store one bit per tile, every row starts with
+ * a new word (bit x % 64 of word y * row_words + x / 64).
+ */
+typedef struct {
+    int width; // width of the floor, must be odd
+    int height;// height of the floor, must be odd
+    map_tile_t* tiles;   // the floor layout (no hidden tiles)
+    uint64_t* seen;      // set for every tile the player has already seen
+    uint64_t* visible;   // set for every tile lit by the current light
+    int row_words;       // the number of words per row of the bit layers
+    int start_edge;      // edge of the start door, NO_EDGE if not generated yet
+    vector2d_t start;    // the position at which the player enters the floor
+    int exit_edge;       // edge of the exit door, NO_EDGE if not generated yet
+    vector2d_t exit;     // the position of the exit door
+    uint64_t version;    // changes whenever the tiles change, unique over all maps
+} map_t;
+
+/**
+ * @brief Access the tile at the given coordinates of a map_t (usable as lvalue).
+ */
+#define MAP_TILE(map, x, y) ((map)->tiles[(y) * (map)->width + (x)])
+/**
+ * @brief Check whether the player has seen the tile at the given coordinates of a map_t (1 or 0).
+ */
+#define MAP_SEEN(map, x, y) (((map)->seen[(y) * (map)->row_words + (x) / 64] >> ((x) % 64)) & 1ULL)
+/**
+ * @brief Mark the tile at the given coordinates of a map_t as seen.
+ */
+#define MAP_REVEAL(map, x, y) ((map)->seen[(y) * (map)->row_words + (x) / 64] |= 1ULL << ((x) % 64))
+/**
+ * @brief Get the tile at the given coordinates of a map_t as the player knows it, HIDDEN if not seen yet.
+ */
+#define MAP_REVEALED(map, x, y) (MAP_SEEN(map, x, y) ? MAP_TILE(map, x, y) : HIDDEN)
+/**
+ * @brief Index of the given coordinates in the tiles of a save, which are stored column by column.
+ */
+#define SAVE_TILE_INDEX(map, x, y) ((x) * (map)->height + (y))
+
 extern vector2d_t directions[4];
 
-//map array
-extern map_tile_t map[WIDTH][HEIGHT];
-extern map_tile_t revealed_map[WIDTH][HEIGHT];
+// the floor the player is currently on
+extern map_t* current_map;
+
+/**
+ * @brief Allocates a new map with the given dimensions.
+ *
+ * All tiles are initialized as WALL and no tile is seen or visible.
+ *
+ * @param width The width of the map (must be odd, between MIN_MAP_WIDTH and MAX_MAP_WIDTH)
+ * @param height The height of the map (must be odd, between MIN_MAP_HEIGHT and MAX_MAP_HEIGHT)
+ * @return The pointer to the new map, or NULL if the dimensions are invalid or the allocation failed.
+ * The map must be freed with free_map().
+ */
+map_t* init_map(int width, int height);
+
+/**
+ * @brief Frees the given map and its tile buffer.
+ *
+ * @param map The map to free, NULL is ignored.
+ */
+void free_map(map_t* map);
+
+/**
+ * @brief Makes sure the current map has the given dimensions.
+ *
+ * When the current map already has the requested size, it is kept as is. Otherwise it is
+ * replaced by a newly allocated map, so the memory always matches the actual floor size.
+ *
+ * @param width The requested width of the map
+ * @param height The requested height of the map
+ * @return COMMON_SUCCESS on success, a non-zero value otherwise
+ */
+int resize_current_map(int width, int height);
+
+/**
+ * @brief Replaces the current map with the given one and frees the old map.
+ *
+ * @param map The map that becomes the current map
+ */
+void replace_current_map(map_t* map);
+
+/**
+ * @brief Marks the tiles of the map as changed by giving it a new version.
+ *
+ * Must be called after the tiles or the revealed tiles were changed other than by moving the
+ * player (e.g. a defeated enemy or a loaded save), so cached results like the light are recomputed.
+ * The versions come from one counter for all maps, so a map that is freed and allocated again at
+ * the same address never gets an old version.
+ *
+ * @param map The changed map
+ */
+void mark_map_changed(map_t* map);
+
+/**
+ * @brief Forgets all seen and visible tiles of the map.
+ *
+ * @param map The map to hide
+ */
+void clear_revealed(map_t* map);
+
+/**
+ * @brief Clears the visible bits in the given area, the area is clipped to the map.
+ *
+ * @param map The map to clear the visible tiles of
+ * @param x_min The first column of the area
+ * @param y_min The first row of the area
+ * @param x_max The last column of the area
+ * @param y_max The last row of the area
+ */
+void clear_visible_area(map_t* map, int x_min, int y_min, int x_max, int y_max);
+
+/**
+ * @brief Marks all visible tiles in the given area as seen, the area is clipped to the map.
+ *
+ * The bit layers are merged 64 tiles at a time.
+ *
+ * @param map The map to merge the visible tiles of
+ * @param x_min The first column of the area
+ * @param y_min The first row of the area
+ * @param x_max The last column of the area
+ * @param y_max The last row of the area
+ */
+void merge_visible_area(map_t* map, int x_min, int y_min, int x_max, int y_max);
+
+/**
+ * @brief Copies the tiles in the order they are stored in a save, see SAVE_TILE_INDEX.
+ *
+ * @param map The map to export
+ * @return A new buffer with one tile per cell, NULL if the allocation failed. The buffer must be
+ * freed by the caller.
+ */
+map_tile_t* export_save_tiles(const map_t* map);
+
+/**
+ * @brief Sets the tiles from a buffer in the order they are stored in a save (the opposite of export_save_tiles).
+ *
+ * @param map The map to import into
+ * @param tiles The buffer with one tile per cell of the map, see SAVE_TILE_INDEX
+ */
+void import_save_tiles(map_t* map, const map_tile_t* tiles);
+
+/**
+ * @brief Expands the seen tiles to one tile per cell, like they are stored in a save.
+ *
+ * @param map The map to export
+ * @return A new buffer with the seen tiles and HIDDEN for all others in the order of a save (see
+ * SAVE_TILE_INDEX), NULL if the allocation failed. The buffer must be freed by the caller.
+ */
+map_tile_t* export_revealed_tiles(const map_t* map);
+
+/**
+ * @brief Marks every tile that is not HIDDEN in the given buffer as seen (the opposite of export_revealed_tiles).
+ *
+ * All other tiles are hidden and nothing is visible afterwards.
+ *
+ * @param map The map to import into
+ * @param revealed The buffer with one tile per cell of the map in the order of a save, see SAVE_TILE_INDEX
+ */
+void import_revealed_tiles(map_t* map, const map_tile_t* revealed);
+
+/**
+ * @brief Restores the exit door information of a map from its tiles.
+ *
+ * Used after the tiles were loaded from a save, where only the tiles are stored.
+ *
+ * @param map The map to search the border of
+ * @return 1 if an exit door was found, 0 otherwise
+ */
+int locate_exit(map_t* map);
+
+/**
+ * @brief Carves an L-shaped corridor of floor tiles between two cells, first horizontally, then vertically.
+ *
+ * Only inner cells are carved, doors and other tiles on the way are kept.
+ *
+ * @param map The map to carve into
+ * @param from The first end of the corridor
+ * @param to The second end of the corridor
+ */
+void carve_corridor(map_t* map, vector2d_t from, vector2d_t to);
 
 #endif//MAP_H
@@ -5,34 +5,45 @@
 #include "map_generator.h"
 
 #include "../logging/logger.h"
+#include "layout/cave_layout.h"
+#include "layout/rooms_layout.h"
 #include "map.h"
-#include "map_mode.h"
 #include "map_populator.h"
+#include "map_regions.h"
 
 #include <stdint.h>
 #include <stdlib.h>
 #include <time.h>
 
-// map array to store the maze
-int visited[WIDTH][HEIGHT];
+#define CARVE_STACK_INITIAL_CAPACITY 1024
 
-int exit_edge = 0;
-int exit_x = 0;
-int exit_y = 0;
+/**
+ * @brief One pending cell of the maze carver.
+ *
+ * Holds the same state the recursive backtracker kept in its stack frame:
+ * the cell, its shuffled directions and the next direction to try.
+ */
+typedef struct {
+    int x;
+    int y;
+    uint8_t dirs[4];// indices into the directions array, in random order
+    uint8_t next;   // index into dirs of the next direction to try
+} carve_frame_t;
 
 
 /**
  * @brief Shuffle array using Fisher-Yates algorithm.
  *
- * This function randomly shuffles the elements of the given array of directions.
+ * This function randomly shuffles the elements of the given array of direction indices.
  *
- * @param dir Array of directions to be shuffled.
+ * @param rng The random number generator to use.
+ * @param dir Array of direction indices to be shuffled.
  * @param n Size of the array.
  */
-void shuffle(vector2d_t* dir, int n) {
+void shuffle(rng_t* rng, uint8_t* dir, int n) {
     for (int i = n - 1; i > 0; i--) {
-        int j = rand() % (i + 1);
-        vector2d_t tmp = dir[j];
+        int j = rng_range(rng, i + 1);
+        uint8_t tmp = dir[j];
         dir[j] = dir[i];
         dir[i] = tmp;
     }
@@ -40,41 +51,45 @@ void shuffle(vector2d_t* dir, int n) {
 
 /**
  * Check if cell is within bounds of the map
+ * @param map the map to check against
  * @param x x coordinate of the cell
  * @param y y coordinate of the cell
  * @return 1 if in bounds, 0 otherwise
  */
-int is_in_bounds(int x, int y) {
-    return x >= 0 && x < WIDTH && y >= 0 && y < HEIGHT;
+int is_in_bounds(const map_t* map, int x, int y) {
+    return x >= 0 && x < map->width && y >= 0 && y < map->height;
 }
 
 /**
  * Check if a cell is a valid cell to visit (in bounds and not visited)
+ * A maze cell counts as visited as soon as it has been carved into a floor.
+ * @param map the map to check against
  * @param x x coordinate of the cell
  * @param y y coordinate of the cell
  * @return 1 if valid, 0 otherwise
  */
-int is_valid_cell(int x, int y) {
-    return is_in_bounds(x, y) && !visited[x][y];
+int is_valid_cell(const map_t* map, int x, int y) {
+    return is_in_bounds(map, x, y) && MAP_TILE(map, x, y) == WALL;
 }
 
 /**
  * Check if the exit position is adjacent to a floor cell
+ * @param map the map to check against
  * @param exit_e the edge of the exit (TOP, BOTTOM, LEFT, RIGHT)
  * @param x x coordinate of the exit
  * @param y y coordinate of the exit
  * @return 1 if valid, 0 otherwise
  */
-int validate_exit_position(int exit_e, int x, int y) {
+int validate_exit_position(const map_t* map, int exit_e, int x, int y) {
     switch (exit_e) {
         case TOP:
-            return map[x][y + 1] == FLOOR;
+            return MAP_TILE(map, x, y + 1) == FLOOR;
         case BOTTOM:
-            return map[x][y - 1] == FLOOR;
+            return MAP_TILE(map, x, y - 1) == FLOOR;
         case LEFT:
-            return map[x + 1][y] == FLOOR;
+            return MAP_TILE(map, x + 1, y) == FLOOR;
         case RIGHT:
-            return map[x - 1][y] == FLOOR;
+            return MAP_TILE(map, x - 1, y) == FLOOR;
         default:
             log_msg(ERROR, "map_generator", "Invalid exit edge: %d", exit_e);
             return 0;
@@ -82,52 +97,100 @@ int validate_exit_position(int exit_e, int x, int y) {
 }
 
 /**
- * Recursive backtracking algorithm to generate map (based on dfs)
+ * @brief Carve the given cell and push it as a new frame on the carve stack.
+ * @param frame the frame to initialize
+ * @param map the map to carve into
+ * @param rng the random number generator to shuffle the directions with
+ * @param x x coordinate of the cell
+ * @param y y coordinate of the cell
+ */
+void push_carve_frame(carve_frame_t* frame, map_t* map, rng_t* rng, const int x, const int y) {
+    MAP_TILE(map, x, y) = FLOOR;
+
+    frame->x = x;
+    frame->y = y;
+    for (uint8_t i = 0; i < 4; i++) {
+        frame->dirs[i] = i;
+    }
+    shuffle(rng, frame->dirs, 4);
+    frame->next = 0;
+}
+
+/**
+ * Backtracking algorithm to generate map (based on dfs)
+ *
+ * Works like the classic recursive backtracker, but keeps the open cells on an explicit
+ * stack on the heap instead of the call stack. This keeps the stack usage constant, so even
+ * floors with millions of cells can be carved. The random numbers are drawn in the same order
+ * as with the recursive version, so the same seed results in the same maze.
+ *
+ * @param map the map to carve the passages into
+ * @param rng the random number generator to use
  * @param x starting x coordinate
  * @param y starting y coordinate
+ * @return COMMON_SUCCESS on success, a non-zero value if the carve stack could not be allocated
  */
-void carve_passages(int x, int y) {
-    visited[x][y] = 1;
-    map[x][y] = FLOOR;
+int carve_passages(map_t* map, rng_t* rng, int x, int y) {
+    size_t capacity = CARVE_STACK_INITIAL_CAPACITY;
+    carve_frame_t* stack = malloc(capacity * sizeof(carve_frame_t));
+    NULL_PTR_HANDLER_RETURN(stack, 1, "map_generator", "Failed to allocate the carve stack");
 
-    // Create a copy of directions and shuffle them
-    vector2d_t shuffled_dirs[4];
-    for (int i = 0; i < 4; i++) {
-        shuffled_dirs[i] = directions[i];
-    }
-    shuffle(shuffled_dirs, 4);
+    size_t top = 0;
+    push_carve_frame(&stack[top++], map, rng, x, y);
 
-    // Try each direction in random order
-    for (int i = 0; i < 4; i++) {
-        int nx = x + shuffled_dirs[i].dx * 2;// Move two cells in the direction
-        int ny = y + shuffled_dirs[i].dy * 2;
+    while (top > 0) {
+        carve_frame_t* current = &stack[top - 1];
 
-        if (is_valid_cell(nx, ny)) {
-            // Carve passage by setting the cell between current and next to FLOOR
-            int wall_x = x + shuffled_dirs[i].dx;
-            int wall_y = y + shuffled_dirs[i].dy;
+        if (current->next >= 4) {
+            // all directions tried, backtrack
+            top--;
+            continue;
+        }
+
+        // Try the next direction in random order
+        const vector2d_t dir = directions[current->dirs[current->next++]];
+        const int nx = current->x + dir.dx * 2;// Move two cells in the direction
+        const int ny = current->y + dir.dy * 2;
 
-            // make the wall a floor and continue the path
-            map[wall_x][wall_y] = FLOOR;
-            carve_passages(nx, ny);
+        if (is_valid_cell(map, nx, ny)) {
+            // Carve passage by setting the cell between current and next to FLOOR
+            MAP_TILE(map, current->x + dir.dx, current->y + dir.dy) = FLOOR;
+
+            if (top == capacity) {
+                // the stack is full, grow it geometrically
+                carve_frame_t* grown = realloc(stack, capacity * 2 * sizeof(carve_frame_t));
+                if (grown == NULL) {
+                    log_msg(ERROR, "map_generator", "Failed to grow the carve stack to %zu frames", capacity * 2);
+                    free(stack);
+                    return 1;
+                }
+                stack = grown;
+                capacity *= 2;
+            }
+            // continue the path from the new cell
+            push_carve_frame(&stack[top++], map, rng, nx, ny);
         }
     }
+
+    free(stack);
+    return COMMON_SUCCESS;
 }
 
 /**
  * Count neighboring floor cells
+ * @param map the map to check against
  * @param x x coordinate of the cell
  * @param y y coordinate of the cell
  * @param neighbor_directions bool array to store on which sides the neighbors are
  * @return number of neighboring floor cells
  */
-int check_neighboring_floors(int x, int y, int neighbor_directions[4]) {
+int check_neighboring_floors(const map_t* map, int x, int y, int neighbor_directions[4]) {
     int count = 0;
     for (int i = 0; i < 4; i++) {
         int dx = x + directions[i].dx;
         int dy = y + directions[i].dy;
 
-        if (map[dx][dy] == FLOOR) {
+        if (MAP_TILE(map, dx, dy) == FLOOR) {
             count++;
             neighbor_directions[i] = 1;
         }
@@ -137,28 +200,30 @@ int check_neighboring_floors(int x, int y, int neighbor_directions[4]) {
 
 /**
  * Add loops to the map by knocking down some walls
+ * @param map the map to add the loops to
+ * @param rng the random number generator to use
  * @param num_loops number of loops to add
  */
-void add_loops(int num_loops) {
+void add_loops(map_t* map, rng_t* rng, int num_loops) {
     int count = 0;
     int max_attempts = num_loops * 10;// Limit the number of attempts
 
     while (count < num_loops && max_attempts > 0) {
         // Pick a random cell
-        int x = 1 + rand() % (WIDTH - 2);
-        int y = 1 + rand() % (HEIGHT - 2);
+        int x = 1 + rng_range(rng, map->width - 2);
+        int y = 1 + rng_range(rng, map->height - 2);
 
         // If the wall has exactly 2 opposing floor neighbors, knock it down to create a loop
-        if (map[x][y] == WALL) {
+        if (MAP_TILE(map, x, y) == WALL) {
             int neighbor_directions[] = {0, 0, 0, 0};
 
-            int floor_count = check_neighboring_floors(x, y, neighbor_directions);
+            int floor_count = check_neighboring_floors(map, x, y, neighbor_directions);
 
             // check if the wall has exactly 2 opposing floor neighbors
             if ((floor_count == 2) &&
                 ((neighbor_directions[TOP] && neighbor_directions[BOTTOM]) ||
                  (neighbor_directions[LEFT] && neighbor_directions[RIGHT]))) {
-                map[x][y] = FLOOR;
+                MAP_TILE(map, x, y) = FLOOR;
                 count++;
             }
         }
@@ -169,63 +234,125 @@ void add_loops(int num_loops) {
 
 /**
  * Place the exit on a random edge of the map, ensuring there's a path to it
- * @param start_edge the edge from which the player enters the map, the exit cannot be on this edge
+ *
+ * The exit is placed on an odd position (like the maze cells) next to a floor cell of the start
+ * region. If no edge has such a position, a corridor is carved from the exit to the start and
+ * the regions are labelled again. Afterwards the exit door belongs to the start region.
+ *
+ * @param map the map to place the exit on, the start edge of the map must already be set
+ * @param rng the random number generator to use
+ * @param regions the region index of the map
+ * @return COMMON_SUCCESS on success, a non-zero value if the candidates could not be allocated
  */
-void place_exit(int start_edge) {
-    // get a random exit edge that is different from the start edge
-    exit_edge = start_edge;
-    while (exit_edge == start_edge) {
-        exit_edge = rand() % 4;
+int place_exit(map_t* map, rng_t* rng, region_index_t* regions) {
+    // the edges different from the start edge in random order
+    uint8_t edges[4];
+    int edge_count = 0;
+    for (uint8_t edge = 0; edge < 4; edge++) {
+        if (edge != map->start_edge) edges[edge_count++] = edge;
     }
-
-    do {
-        switch (exit_edge) {
-            case TOP:
-                exit_x = 1 + 2 * (rand() % ((WIDTH - 2) / 2));
-                exit_y = 0;
-                break;
-            case BOTTOM:
-                exit_x = 1 + 2 * (rand() % ((WIDTH - 2) / 2));
-                exit_y = HEIGHT - 1;
-                break;
-            case LEFT:
-                exit_x = 0;
-                exit_y = 1 + 2 * (rand() % ((HEIGHT - 2) / 2));
-                break;
-            case RIGHT:
-                exit_x = WIDTH - 1;
-                exit_y = 1 + 2 * (rand() % ((HEIGHT - 2) / 2));
-                break;
-            default:
-                log_msg(ERROR, "map_generator", "Invalid exit edge: %d", exit_edge);
-                return;
+    shuffle(rng, edges, edge_count);
+
+    const int longest_edge = map->width > map->height ? map->width : map->height;
+    int* candidates = malloc((size_t) longest_edge * sizeof(int));
+    NULL_PTR_HANDLER_RETURN(candidates, 1, "map_generator", "Failed to allocate the exit candidates");
+
+    int exit_edge = edges[0];
+    int exit_x = -1;
+    int exit_y = -1;
+    for (int e = 0; e < edge_count && exit_x == -1; e++) {
+        const int edge = edges[e];
+        const int length = edge == TOP || edge == BOTTOM ? map->width : map->height;
+        int count = 0;
+        for (int i = 1; i < length - 1; i += 2) {
+            const int x = edge == TOP || edge == BOTTOM ? i : (edge == LEFT ? 0 : map->width - 1);
+            const int y = edge == LEFT || edge == RIGHT ? i : (edge == TOP ? 0 : map->height - 1);
+            if (validate_exit_position(map, edge, x, y) &&
+                is_in_start_region(regions, map, x - directions[edge].dx, y - directions[edge].dy)) {
+                candidates[count++] = i;
+            }
         }
-    } while (!validate_exit_position(exit_edge, exit_x, exit_y));
+        if (count == 0) continue;
+
+        const int i = candidates[rng_range(rng, count)];
+        exit_edge = edge;
+        exit_x = edge == TOP || edge == BOTTOM ? i : (edge == LEFT ? 0 : map->width - 1);
+        exit_y = edge == LEFT || edge == RIGHT ? i : (edge == TOP ? 0 : map->height - 1);
+    }
+    free(candidates);
+
+    const int carved = exit_x == -1;
+    if (carved) {
+        // no floor of the start region touches any edge, connect a random position to the start instead
+        const int length = exit_edge == TOP || exit_edge == BOTTOM ? map->width : map->height;
+        const int i = 1 + 2 * rng_range(rng, (length - 1) / 2);
+        exit_x = exit_edge == TOP || exit_edge == BOTTOM ? i : (exit_edge == LEFT ? 0 : map->width - 1);
+        exit_y = exit_edge == LEFT || exit_edge == RIGHT ? i : (exit_edge == TOP ? 0 : map->height - 1);
+        const vector2d_t inside = {exit_x - directions[exit_edge].dx, exit_y - directions[exit_edge].dy};
+        carve_corridor(map, inside, map->start);
+    }
 
-    map[exit_x][exit_y] = EXIT_DOOR;
+    MAP_TILE(map, exit_x, exit_y) = EXIT_DOOR;
+    map->exit_edge = exit_edge;
+    map->exit.dx = exit_x;
+    map->exit.dy = exit_y;
+
+    if (carved) {
+        // the corridor may have joined several regions
+        return build_region_index(regions, map);
+    }
+    // the door only extends the region of the cell in front of it
+    const int start_region = get_start_region(regions, map);
+    REGION_AT(regions, exit_x, exit_y) = start_region;
+    regions->sizes[start_region]++;
+    return COMMON_SUCCESS;
 }
 
 
 /**
  * @brief Initialize the map with walls
+ * @param map the map to initialize
  */
-void initialize_map() {
-    for (int y = 0; y < HEIGHT; y++) {
-        for (int x = 0; x < WIDTH; x++) {
-            map[x][y] = WALL;
-            revealed_map[x][y] = HIDDEN;
-            visited[x][y] = 0;
-        }
+void initialize_map(map_t* map) {
+    const int cells = map->width * map->height;
+    for (int i = 0; i < cells; i++) {
+        map->tiles[i] = WALL;
     }
+    clear_revealed(map);
+    mark_map_changed(map);
+}
+
+/**
+ * @brief Returns the current timestamp in nanoseconds, only used when the generation is timed.
+ * @return the current time in nanoseconds
+ */
+uint64_t timing_now_ns(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
 }
 
 /**
- * @brief Generate a new maze using recursive backtracking
+ * @brief Adds the time since the given timestamp to the given counter and restarts the timestamp.
+ * @param counter the counter to add the elapsed time to
+ * @param since the timestamp of the start of the phase, set to the current time
+ */
+void add_elapsed_ns(uint64_t* counter, uint64_t* since) {
+    const uint64_t now = timing_now_ns();
+    *counter += now - *since;
+    *since = now;
+}
+
+/**
+ * @brief Generate a new maze using backtracking, starting at the start position of the map
  *
- * @param start_x Starting x coordinate
- * @param start_y Starting y coordinate
+ * @param map the map to generate the maze in
+ * @param rng the random number generator to use
+ * @return COMMON_SUCCESS on success, a non-zero value otherwise
  */
-void generate_maze(int start_x, int start_y) {
+int generate_maze(map_t* map, rng_t* rng) {
+    int start_x = map->start.dx;
+    int start_y = map->start.dy;
     // Make sure start position is valid for dfs (odd coordinates)
     // relevant if we want to implement the starting position differently
     if (start_x % 2 == 0) {
@@ -235,41 +362,52 @@ void generate_maze(int start_x, int start_y) {
         start_y++;
     }
 
-    // Generate the map using recursive backtracking
-    carve_passages(start_x, start_y);
-
-    // Add some loops to the map
-    int num_loops = (WIDTH * HEIGHT) / 100 + 1;// Use fewer loops to prevent overflow
-    add_loops(num_loops);
+    // Generate the map using backtracking
+    if (carve_passages(map, rng, start_x, start_y) != COMMON_SUCCESS) {
+        log_msg(ERROR, "map_generator", "Failed to carve the maze");
+        return 1;
+    }
+    return COMMON_SUCCESS;
 }
 
+const layout_generator_t layout_generators[MAX_LAYOUTS] = {
+        [LAYOUT_MAZE] = {"maze", generate_maze, 1},
+        [LAYOUT_ROOMS] = {"rooms", generate_rooms_layout, 0},
+        [LAYOUT_CAVE] = {"cave", generate_cave_layout, 0},
+};
+
+// the layouts of the floors, repeated after the last entry
+const floor_layout_t floor_layout_rotation[] = {LAYOUT_MAZE, LAYOUT_MAZE, LAYOUT_ROOMS, LAYOUT_MAZE, LAYOUT_CAVE};
+
 /**
- * @brief Set the start position on the map
+ * @brief Set a random start position on the map
+ * Start position must be an odd coordinate (for dfs) and should be at least 3 cells away from other edges (not start_edge)
+ * @param map the map to set the start door on
+ * @param rng the random number generator to use
  * @param start_edge the edge from which the player enters the map
- * @param start_x pointer to the x coordinate of the start position
- * @param start_y pointer to the y coordinate of the start position
  */
-void set_start_position(int start_edge, int* start_x, int* start_y) {
+void set_start_position(map_t* map, rng_t* rng, const int start_edge) {
+    map->start_edge = start_edge;
     switch (start_edge) {
         case TOP:
-            *start_x = 3 + 2 * (rand() % ((WIDTH - 5) / 2));
-            *start_y = 1;
-            map[*start_x][0] = START_DOOR;
+            map->start.dx = 3 + 2 * rng_range(rng, (map->width - 5) / 2);
+            map->start.dy = 1;
+            MAP_TILE(map, map->start.dx, 0) = START_DOOR;
             break;
         case RIGHT:
-            *start_x = WIDTH - 2;
-            *start_y = 3 + 2 * (rand() % ((HEIGHT - 5) / 2));
-            map[WIDTH - 1][*start_y] = START_DOOR;
+            map->start.dx = map->width - 2;
+            map->start.dy = 3 + 2 * rng_range(rng, (map->height - 5) / 2);
+            MAP_TILE(map, map->width - 1, map->start.dy) = START_DOOR;
             break;
         case BOTTOM:
-            *start_x = 3 + 2 * (rand() % ((WIDTH - 5) / 2));
-            *start_y = HEIGHT - 2;
-            map[*start_x][HEIGHT - 1] = START_DOOR;
+            map->start.dx = 3 + 2 * rng_range(rng, (map->width - 5) / 2);
+            map->start.dy = map->height - 2;
+            MAP_TILE(map, map->start.dx, map->height - 1) = START_DOOR;
             break;
         case LEFT:
-            *start_x = 1;
-            *start_y = 3 + 2 * (rand() % ((HEIGHT - 5) / 2));
-            map[0][*start_y] = START_DOOR;
+            map->start.dx = 1;
+            map->start.dy = 3 + 2 * rng_range(rng, (map->height - 5) / 2);
+            MAP_TILE(map, 0, map->start.dy) = START_DOOR;
             break;
         default:
             log_msg(ERROR, "map_generator", "Invalid start edge: %d", start_edge);
@@ -278,35 +416,36 @@ void set_start_position(int start_edge, int* start_x, int* start_y) {
 }
 
 /**
- * @brief Set the start position on the map based on the previous exit position
- * @param start_x pointer to the x coordinate of the start position
- * @param start_y pointer to the y coordinate of the start position
+ * @brief Set the start position on the map based on the exit position of the previous floor
+ * @param map the map to set the start door on
+ * @param exit_edge the edge of the exit door on the previous floor
+ * @param exit the position of the exit door on the previous floor
  */
-void make_exit_into_start(int* start_edge, int* start_x, int* start_y) {
+void make_exit_into_start(map_t* map, const int exit_edge, const vector2d_t exit) {
     switch (exit_edge) {
         case TOP:
-            *start_edge = BOTTOM;
-            *start_x = exit_x;
-            *start_y = HEIGHT - 2;
-            map[*start_x][HEIGHT - 1] = START_DOOR;
+            map->start_edge = BOTTOM;
+            map->start.dx = exit.dx;
+            map->start.dy = map->height - 2;
+            MAP_TILE(map, map->start.dx, map->height - 1) = START_DOOR;
             break;
         case RIGHT:
-            *start_edge = LEFT;
-            *start_x = 1;
-            *start_y = exit_y;
-            map[0][*start_y] = START_DOOR;
+            map->start_edge = LEFT;
+            map->start.dx = 1;
+            map->start.dy = exit.dy;
+            MAP_TILE(map, 0, map->start.dy) = START_DOOR;
             break;
         case BOTTOM:
-            *start_edge = TOP;
-            *start_x = exit_x;
-            *start_y = 1;
-            map[*start_x][0] = START_DOOR;
+            map->start_edge = TOP;
+            map->start.dx = exit.dx;
+            map->start.dy = 1;
+            MAP_TILE(map, map->start.dx, 0) = START_DOOR;
             break;
         case LEFT:
-            *start_edge = RIGHT;
-            *start_x = WIDTH - 2;
-            *start_y = exit_y;
-            map[WIDTH - 1][*start_y] = START_DOOR;
+            map->start_edge = RIGHT;
+            map->start.dx = map->width - 2;
+            map->start.dy = exit.dy;
+            MAP_TILE(map, map->width - 1, map->start.dy) = START_DOOR;
             break;
         default:
             log_msg(ERROR, "map_generator", "Invalid exit edge: %d", exit_edge);
@@ -314,35 +453,101 @@ void make_exit_into_start(int* start_edge, int* start_x, int* start_y) {
     }
 }
 
-void generate_map() {
-    // Better random seed using a combination of time and process info
-    unsigned int seed = (unsigned int) time(NULL);
-    // XOR with address of a stack variable to add more entropy
-    int stack_var;
-    seed ^= (uintptr_t) &stack_var;
-    srand(seed);
+/**
+ * @brief Check if the exit of the previous floor can be used as the start of the given map.
+ * The previous floor may have been larger (e.g. after loading a save) or may not have an exit at all.
+ * @param map the map to check against
+ * @param exit_edge the edge of the exit door on the previous floor
+ * @param exit the position of the exit door on the previous floor
+ * @return 1 if the previous exit can be reused, 0 otherwise
+ */
+int can_reuse_exit(const map_t* map, const int exit_edge, const vector2d_t exit) {
+    if (exit_edge == TOP || exit_edge == BOTTOM) {
+        return exit.dx >= 1 && exit.dx <= map->width - 2;
+    }
+    if (exit_edge == LEFT || exit_edge == RIGHT) {
+        return exit.dy >= 1 && exit.dy <= map->height - 2;
+    }
+    // No exit yet, so this is the first floor
+    return 0;
+}
+
+floor_layout_t get_floor_layout(const int floor) {
+    const int rotation_length = (int) (sizeof(floor_layout_rotation) / sizeof(floor_layout_rotation[0]));
+    const int index = floor > 1 ? (floor - 1) % rotation_length : 0;
+    return floor_layout_rotation[index];
+}
+
+void get_floor_dimensions(const int floor, int* width, int* height) {
+    const int steps = floor > 1 ? floor - 1 : 0;
+
+    *width = DEFAULT_MAP_WIDTH + steps * FLOOR_GROWTH_WIDTH;
+    *height = DEFAULT_MAP_HEIGHT + steps * FLOOR_GROWTH_HEIGHT;
+    if (*width > MAX_FLOOR_WIDTH) *width = MAX_FLOOR_WIDTH;
+    if (*height > MAX_FLOOR_HEIGHT) *height = MAX_FLOOR_HEIGHT;
+}
+
+int generate_map(map_t* map, const map_t* previous_floor, const uint64_t seed, const floor_layout_t layout) {
+    return generate_map_timed(map, previous_floor, seed, layout, NULL);
+}
+
+int generate_map_timed(map_t* map, const map_t* previous_floor, const uint64_t seed, const floor_layout_t layout, generation_timing_t* timing) {
+    NULL_PTR_HANDLER_RETURN(map, 1, "map_generator", "In generate_map given map is NULL");
+    CHECK_ARG_RETURN(layout < 0 || layout >= MAX_LAYOUTS, 1, "map_generator", "Invalid floor layout: %d", layout);
+    uint64_t phase_start = timing != NULL ? timing_now_ns() : 0;
+
+    // read the previous exit first, the previous floor may be the same map
+    const int previous_exit_edge = previous_floor != NULL ? previous_floor->exit_edge : NO_EDGE;
+    const vector2d_t previous_exit = previous_floor != NULL ? previous_floor->exit : (vector2d_t) {0, 0};
+
+    rng_t rng;
+    init_rng(&rng, seed);
 
     // Initialize the map with walls
-    initialize_map();
+    initialize_map(map);
 
-    int start_x = 0;
-    int start_y = 0;
-    int start_edge = 0;
-    if (!exit_x && !exit_y) {
-        // No exit yet, so this is the first time generating the map
-        // Generate map with a random start position (at the start_edge)
-        // Start position must be an odd coordinate (for dfs) and should be at least 3 cells away from other edges (not start_edge)
-        start_edge = rand() % 4;
-        set_start_position(start_edge, &start_x, &start_y);
+    if (can_reuse_exit(map, previous_exit_edge, previous_exit)) {
+        make_exit_into_start(map, previous_exit_edge, previous_exit);
     } else {
-        make_exit_into_start(&start_edge, &start_x, &start_y);
+        // Generate map with a random start position (at the start_edge)
+        set_start_position(map, &rng, rng_range(&rng, 4));
     }
 
-    generate_maze(start_x, start_y);
+    const layout_generator_t* generator = &layout_generators[layout];
+    if (generator->carve(map, &rng) != COMMON_SUCCESS) {
+        log_msg(ERROR, "map_generator", "Failed to carve the %s layout", generator->name);
+        return 1;
+    }
+    if (timing != NULL) add_elapsed_ns(&timing->carve_ns, &phase_start);
 
-    place_exit(start_edge);
+    if (generator->add_loops) {
+        // Add some loops to the map
+        int num_loops = (map->width * map->height) / 100 + 1;// Use fewer loops to prevent overflow
+        add_loops(map, &rng, num_loops);
+    }
+    if (timing != NULL) add_elapsed_ns(&timing->loops_ns, &phase_start);
 
-    populate_map();
+    region_index_t* regions = init_region_index(map->width, map->height);
+    NULL_PTR_HANDLER_RETURN(regions, 1, "map_generator", "Failed to allocate the region index");
+    if (build_region_index(regions, map) != COMMON_SUCCESS) {
+        free_region_index(regions);
+        return 1;
+    }
+    if (timing != NULL) add_elapsed_ns(&timing->regions_ns, &phase_start);
 
-    set_player_start_pos(start_x, start_y);
+    if (place_exit(map, &rng, regions) != COMMON_SUCCESS) {
+        free_region_index(regions);
+        return 1;
+    }
+    if (timing != NULL) add_elapsed_ns(&timing->exit_ns, &phase_start);
+
+    const populate_result_t populated = populate_map(map, &rng, regions, ENEMY_COUNT);
+    free_region_index(regions);
+    // small floors get fewer enemies, the rest of the floor is complete
+    if (populated != POPULATE_SUCCESS && populated != POPULATE_FEWER_ENEMIES) {
+        log_msg(ERROR, "map_generator", "Failed to populate the %d x %d floor", map->width, map->height);
+        return 1;
+    }
+    if (timing != NULL) add_elapsed_ns(&timing->populate_ns, &phase_start);
+    return COMMON_SUCCESS;
 }
@@ -5,9 +5,99 @@
 #ifndef MAP_GENERATOR_H
 #define MAP_GENERATOR_H
 
+#include "../random/rng.h"
+#include "map.h"
+
+#include <stdint.h>
+
+#define FLOOR_GROWTH_WIDTH 4 // added to the width per floor, must be even
+#define FLOOR_GROWTH_HEIGHT 2// added to the height per floor, must be even
+#define MAX_FLOOR_WIDTH 79   // the width stops growing here, must be odd
+#define MAX_FLOOR_HEIGHT 39  // the height stops growing here, must be odd
+
+typedef enum {
+    LAYOUT_MAZE, // a maze carved with a backtracker, with some loops
+    LAYOUT_ROOMS,// rooms connected with corridors
+    LAYOUT_CAVE, // caves grown with a cellular automata
+    MAX_LAYOUTS
+} floor_layout_t;
+
+/**
+ * @brief An algorithm that carves the layout of a floor.
+ *
+ * The carve function gets a map that only contains walls and the start door. It must make the
+ * start position of the map a floor and connect every floor it carves to it. The exit and the
+ * items are placed afterwards by the generator, the same way for every layout.
+ */
+typedef struct {
+    const char* name;
+    int (*carve)(map_t* map, rng_t* rng);// returns COMMON_SUCCESS on success
+    int add_loops;                       // 1 if walls should be knocked down afterwards to add loops
+} layout_generator_t;
+
+// the available layouts, indexed by floor_layout_t
+extern const layout_generator_t layout_generators[MAX_LAYOUTS];
+
+/**
+ * @brief Time spent in the phases of the map generation, in nanoseconds.
+ */
+typedef struct {
+    uint64_t carve_ns;   // clearing the map, placing the start and carving the layout
+    uint64_t loops_ns;   // knocking down walls to add loops
+    uint64_t regions_ns; // labelling the connected regions
+    uint64_t exit_ns;    // placing the exit
+    uint64_t populate_ns;// placing the key, enemies and fountains
+} generation_timing_t;
+
+/**
+ * @brief Get the layout of the given floor.
+ *
+ * @param floor The floor number (starting at 1)
+ * @return The layout of the floor, the first floor is always a maze
+ */
+floor_layout_t get_floor_layout(int floor);
+
+/**
+ * @brief Get the dimensions of the map for the given floor.
+ *
+ * The first floor has the size DEFAULT_MAP_WIDTH x DEFAULT_MAP_HEIGHT, every deeper floor
+ * grows by FLOOR_GROWTH_WIDTH x FLOOR_GROWTH_HEIGHT until MAX_FLOOR_WIDTH x MAX_FLOOR_HEIGHT is reached.
+ *
+ * @param floor The floor number (starting at 1)
+ * @param width Pointer to store the width of the floor
+ * @param height Pointer to store the height of the floor
+ */
+void get_floor_dimensions(int floor, int* width, int* height);
+
 /**
  * @brief Generate the map and populate it with keys, enemies, and the exit
+ *
+ * The generator only uses its own random number generator seeded with the given seed, so the
+ * same seed and previous floor always produce the same floor and several floors can be
+ * generated on different threads at the same time.
+ *
+ * @param map The map to generate the floor into, its dimensions define the size of the floor
+ * @param previous_floor The floor before this one, its exit becomes the start of the new floor.
+ * May be NULL or the same map as map.
+ * @param seed The seed of the floor (see derive_seed in rng.h)
+ * @param layout The layout algorithm of the floor (see get_floor_layout)
+ * @return COMMON_SUCCESS on success, a non-zero value otherwise
+ */
+int generate_map(map_t* map, const map_t* previous_floor, uint64_t seed, floor_layout_t layout);
+
+/**
+ * @brief Same as generate_map, but measures how long each phase of the generation takes.
+ *
+ * The measured times are added to the given timing, so the times of several floors can be summed up.
+ * Intended for benchmarks, generate_map does not take the time.
+ *
+ * @param map The map to generate the floor into
+ * @param previous_floor The floor before this one, may be NULL or the same map as map
+ * @param seed The seed of the floor
+ * @param layout The layout algorithm of the floor
+ * @param timing The timing to add the measured times to, may be NULL
+ * @return COMMON_SUCCESS on success, a non-zero value otherwise
  */
-void generate_map();
+int generate_map_timed(map_t* map, const map_t* previous_floor, uint64_t seed, floor_layout_t layout, generation_timing_t* timing);
 
 #endif//MAP_GENERATOR_H
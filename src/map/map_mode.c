@@ -11,6 +11,7 @@
 #include "../io/output/common/output_handler.h"
 #include "../io/output/specific/map_output.h"
 #include "draw/draw_light.h"
+#include "draw/light_map.h"
 #include "map.h"
 
 #include <stdbool.h>
@@ -20,14 +21,42 @@
 vector2d_t map_anchor = {5, 2};
 vector2d_t player_pos;
 int player_has_key = 0;
-bool first_function_call = true;
 int current_floor = 1;
+// the last light that was drawn, the light is only drawn again if the player or the map changed
+light_cache_t light_cache = LIGHT_CACHE_EMPTY;
+// the placed lights of the current floor and the map version they were placed for
+light_map_t* floor_lights = NULL;
+uint64_t floor_lights_version = 0;
+
+/**
+ * @brief Places the lights of the current floor again if the floor changed since they were placed.
+ */
+void update_floor_lights(void) {
+    if (floor_lights != NULL && floor_lights->width == current_map->width && floor_lights->height == current_map->height) {
+        if (floor_lights_version == current_map->version) return;
+        clear_light_map(floor_lights);
+    } else {
+        free_light_map(floor_lights);
+        floor_lights = init_light_map(current_map->width, current_map->height);
+        if (floor_lights == NULL) return;
+    }
+
+    for (int y = 0; y < current_map->height; y++) {
+        for (int x = 0; x < current_map->width; x++) {
+            const map_tile_t tile = MAP_TILE(current_map, x, y);
+            if (tile == LIFE_FOUNTAIN || tile == MANA_FOUNTAIN) {
+                add_light_source(floor_lights, current_map, (vector2d_t) {x, y}, FOUNTAIN_LIGHT_RADIUS, FOUNTAIN_LIGHT_INTENSITY);
+            }
+        }
+    }
+    floor_lights_version = current_map->version;
+}
 
 void set_player_start_pos(const int player_x, const int player_y) {
     player_pos.dx = player_x;
     player_pos.dy = player_y;
     // at the start, tile under the player must be revealed
-    revealed_map[player_pos.dx][player_pos.dy] = FLOOR;
+    MAP_REVEAL(current_map, player_pos.dx, player_pos.dy);
 }
 
 vector2d_t get_player_pos() {
@@ -65,8 +94,8 @@ map_mode_result_t handle_input(const input_event_t* input_event, character_t* pl
     }
 
 
-    if (new_x >= 0 && new_x < WIDTH && new_y >= 0 && new_y < HEIGHT) {
-        switch (map[new_x][new_y]) {
+    if (new_x >= 0 && new_x < current_map->width && new_y >= 0 && new_y < current_map->height) {
+        switch (MAP_TILE(current_map, new_x, new_y)) {
             case WALL:
             // ignore wall
             // break;
@@ -77,7 +106,7 @@ map_mode_result_t handle_input(const input_event_t* input_event, character_t* pl
                 player_has_key = 1;
                 player_pos.dx = new_x;
                 player_pos.dy = new_y;
-                revealed_map[new_x][new_y] = FLOOR;
+                MAP_REVEAL(current_map, new_x, new_y);
                 break;
             case EXIT_DOOR:
                 if (player_has_key) {
@@ -92,20 +121,28 @@ map_mode_result_t handle_input(const input_event_t* input_event, character_t* pl
                 player->current_resources.health = player->max_resources.health;
                 player_pos.dx = new_x;
                 player_pos.dy = new_y;
-                revealed_map[new_x][new_y] = FLOOR;
+                MAP_REVEAL(current_map, new_x, new_y);
                 break;
             case MANA_FOUNTAIN:
                 player->current_resources.mana = player->max_resources.mana;
                 player_pos.dx = new_x;
                 player_pos.dy = new_y;
-                revealed_map[new_x][new_y] = FLOOR;
+                MAP_REVEAL(current_map, new_x, new_y);
                 break;
-            case GOBLIN:
+            case GOBLIN: {
+                const bool lights_placed = floor_lights != NULL && floor_lights_version == current_map->version;
                 player_pos.dx = new_x;
                 player_pos.dy = new_y;
-                map[new_x][new_y] = FLOOR;
-                revealed_map[new_x][new_y] = FLOOR;
+                MAP_TILE(current_map, new_x, new_y) = FLOOR;
+                MAP_REVEAL(current_map, new_x, new_y);
+                mark_map_changed(current_map);
+                // the rest of the floor is unchanged, only the lights reaching the goblin are cast again,
+                // if that fails all lights are placed again with the next update
+                if (lights_placed && update_light_area(floor_lights, current_map, new_x, new_y, new_x, new_y) >= 0) {
+                    floor_lights_version = current_map->version;
+                }
                 return COMBAT;
+            }
             default:
                 player_pos.dx = new_x;
                 player_pos.dy = new_y;
@@ -116,25 +153,23 @@ map_mode_result_t handle_input(const input_event_t* input_event, character_t* pl
 }
 
 map_mode_result_t map_mode_update(character_t* player) {
-    map_mode_result_t next_state = CONTINUE;
+    // draw first, so the map is up to date while the game waits for the player
+    update_floor_lights();
+    update_light(&light_cache, current_map, floor_lights, player_pos, LIGHT_RADIUS, SIGHT_RADIUS);
+    // only the changed cells are drawn and rendered, the screen is cleared when the map is drawn the first time
+    draw_map_mode(current_map, map_anchor, player_pos);
 
-    if (!first_function_call) {
-        input_event_t input_event;
-
-        // Use our input handler to get input
-        if (get_input_nonblocking(&input_event)) {
-            next_state = handle_input(&input_event, player);
-        }
+    // sleep until a key is pressed, nothing changes on the map in the meantime
+    map_mode_result_t next_state = CONTINUE;
+    input_event_t input_event;
+    if (get_input_timeout(&input_event, INPUT_IDLE_TIMEOUT_MS)) {
+        next_state = handle_input(&input_event, player);
     }
-    first_function_call = false;
-
-    // clear screen using the IO handler
-    clear_screen();
-    draw_light_on_player((map_tile_t*) map, (map_tile_t*) revealed_map, HEIGHT, WIDTH, player_pos, LIGHT_RADIUS);
-    draw_map_mode((const map_tile_t*) revealed_map, HEIGHT, WIDTH, map_anchor, player_pos);
-    // Use the centralized render function instead of direct notcurses call
-    render_frame();
 
+    if (next_state != CONTINUE) {
+        // the map lies on its own planes, the next mode needs the whole screen
+        hide_map_mode();
+    }
     if (next_state == NEXT_FLOOR) {
         draw_transition_screen();
     }
@@ -142,14 +177,21 @@ map_mode_result_t map_mode_update(character_t* player) {
     return next_state;
 }
 
-void init_map_mode(void) {
-    for (int y = 0; y < HEIGHT; y++) {
-        for (int x = 0; x < WIDTH; x++) {
-            revealed_map[x][y] = HIDDEN;
-        }
+int init_map_mode(void) {
+    // the map of the first floor, gets resized when a floor is generated or loaded
+    if (resize_current_map(DEFAULT_MAP_WIDTH, DEFAULT_MAP_HEIGHT) != COMMON_SUCCESS) {
+        log_msg(ERROR, "map_mode", "Failed to allocate the map");
+        return 1;
     }
+    clear_revealed(current_map);
+    mark_map_changed(current_map);
+    return COMMON_SUCCESS;
 }
 
 void shutdown_map_mode(void) {
-    // Free any resources if needed
+    shutdown_map_output();
+    free_light_map(floor_lights);
+    floor_lights = NULL;
+    free_map(current_map);
+    current_map = NULL;
 }
@@ -14,6 +14,9 @@
 #define COLOR_BACKGROUND 0x000000// Black
 
 #define LIGHT_RADIUS 3
+#define SIGHT_RADIUS 12// the player sees tiles lit by placed lights up to this many steps away
+#define FOUNTAIN_LIGHT_RADIUS 4
+#define FOUNTAIN_LIGHT_INTENSITY 160
 
 typedef enum {
     CONTINUE,
@@ -42,15 +45,17 @@ void set_player_start_pos(int player_x, int player_y);
 vector2d_t get_player_pos();
 
 /**
- * Updates the player position based on the player's input and redraws the maze.
+ * Redraws the maze and updates the player position based on the player's input.
+ * Waits for the input at most INPUT_IDLE_TIMEOUT_MS, an idle map does not use the CPU.
  * @return CONTINUE (0) if the game continue, QUIT (1) if the player pressed the exit key.
  */
 map_mode_result_t map_mode_update(character_t* player);
 
 /**
- * @brief Initializes the map mode
+ * @brief Initializes the map mode and allocates the map for the first floor.
+ * @return COMMON_SUCCESS on success, a non-zero value otherwise
  */
-void init_map_mode(void);
+int init_map_mode(void);
 /**
  * @brief Frees any resources associated with the map mode.
  */
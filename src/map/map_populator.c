@@ -4,17 +4,32 @@
  */
 #include "map_populator.h"
 
+#include "../logging/logger.h"
 #include "map.h"
 
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+
+#define CANDIDATE_LIST_INITIAL_CAPACITY 256
+
+/**
+ * @brief A growable list of cell indices (y * width + x) to place items on.
+ */
+typedef struct {
+    int* cells;
+    int count;
+    int capacity;
+} candidate_list_t;
 
 /**
  * Check if a cell is a dead end (is floor and has only one neighboring non-wall cell)
+ * @param map the map to check against
  * @param x the x coordinate of the cell
  * @param y the y coordinate of the cell
  * @return 1 if the cell is a dead end, 0 otherwise
  */
-int is_dead_end(int x, int y) {
+int is_dead_end(const map_t* map, int x, int y) {
     // Count neighboring non-wall cells
     int neighbor_count = 0;
 
@@ -22,95 +37,227 @@ int is_dead_end(int x, int y) {
         int dx = x + directions[i].dx;
         int dy = y + directions[i].dy;
 
-        if (map[dx][dy] != WALL) {
+        if (MAP_TILE(map, dx, dy) != WALL) {
             neighbor_count++;
         }
     }
 
-    return neighbor_count == 1 && map[x][y] == FLOOR;
+    return neighbor_count == 1 && MAP_TILE(map, x, y) == FLOOR;
 }
 
 
 /**
- * @brief Place a key in a dead end that is not the start or exit edge
+ * @brief Append a cell index to the given candidate list, the list grows as needed.
+ * @param list the list to append to
+ * @param cell the index of the cell (y * width + x)
+ * @return COMMON_SUCCESS on success, a non-zero value if the list could not grow
  */
-void place_key() {
-    int x;
-    int y;
-
-    // place the key in the first dead end found
-    do {
-        x = rand() % (WIDTH - 2) + 1;
-        y = rand() % (HEIGHT - 2) + 1;
-    } while (!is_dead_end(x, y));
+int push_candidate(candidate_list_t* list, const int cell) {
+    if (list->count == list->capacity) {
+        const int capacity = list->capacity > 0 ? list->capacity * 2 : CANDIDATE_LIST_INITIAL_CAPACITY;
+        int* cells = realloc(list->cells, (size_t) capacity * sizeof(int));
+        NULL_PTR_HANDLER_RETURN(cells, 1, "map_populator", "Failed to grow the candidate list to %d cells", capacity);
+        list->cells = cells;
+        list->capacity = capacity;
+    }
+    list->cells[list->count++] = cell;
+    return COMMON_SUCCESS;
+}
 
-    map[x][y] = KEY;
+/**
+ * @brief Remove a random cell from the candidate list (sampling without replacement).
+ * @param list the list to take the cell from, must not be empty
+ * @param rng the random number generator to use
+ * @return the index of the removed cell
+ */
+int take_random_candidate(candidate_list_t* list, rng_t* rng) {
+    const int i = rng_range(rng, list->count);
+    const int cell = list->cells[i];
+    list->cells[i] = list->cells[--list->count];
+    return cell;
 }
 
+/**
+ * @brief Collect the dead ends and the floor cells of the map in one scan over the inner cells.
+ * @param map the map to scan
+ * @param regions the region index of the map, only cells of the start region are collected (NULL for all cells)
+ * @param dead_ends the list to collect the dead ends in
+ * @param floors the list to collect all floor cells in (including the dead ends)
+ * @return COMMON_SUCCESS on success, a non-zero value if a list could not grow
+ */
+int collect_candidates(const map_t* map, const region_index_t* regions, candidate_list_t* dead_ends, candidate_list_t* floors) {
+    const int start_region = regions != NULL ? get_start_region(regions, map) : NO_REGION;
+    for (int y = 1; y < map->height - 1; y++) {
+        for (int x = 1; x < map->width - 1; x++) {
+            if (MAP_TILE(map, x, y) != FLOOR) continue;
+
+            const int cell = y * map->width + x;
+            if (regions != NULL && regions->labels[cell] != start_region) continue;
+            if (push_candidate(floors, cell) != COMMON_SUCCESS) return 1;
+            if (is_dead_end(map, x, y) && push_candidate(dead_ends, cell) != COMMON_SUCCESS) return 1;
+        }
+    }
+    return COMMON_SUCCESS;
+}
 
 /**
- * @brief Check if a cell is close to an enemy (based on ENEMY_MIN_DISTANCE)
- * @param x the x coordinate of the cell
- * @param y the y coordinate of the cell
- * @return 1 if the cell is close to an enemy, 0 otherwise
+ * @brief Place the tile on a random dead end, that is still a floor
+ *
+ * Layouts without dead ends (e.g. rooms and caves) use any remaining floor cell instead.
+ *
+ * @param map the map to place the tile on
+ * @param rng the random number generator to use
+ * @param dead_ends the remaining dead ends, the used dead end is removed
+ * @param floors the remaining floor cells, used when no dead end is left
+ * @param tile the tile to place
+ * @return COMMON_SUCCESS on success, a non-zero value if no free cell is left
  */
-int is_close_to_enemy(int x, int y) {
-    for (int i = -ENEMY_MIN_DISTANCE; i <= ENEMY_MIN_DISTANCE + 1; i++) {
-        for (int j = -ENEMY_MIN_DISTANCE; j <= ENEMY_MIN_DISTANCE + 1; j++) {
-            if (map[x + i][y + j] == GOBLIN || map[x + i][y + j] == START_DOOR) {
-                return 1;
+int place_in_dead_end(map_t* map, rng_t* rng, candidate_list_t* dead_ends, candidate_list_t* floors, const map_tile_t tile) {
+    candidate_list_t* lists[2] = {dead_ends, floors};
+    for (int l = 0; l < 2; l++) {
+        while (lists[l]->count > 0) {
+            const int cell = take_random_candidate(lists[l], rng);
+            // an enemy or another item may already stand on this cell
+            if (map->tiles[cell] == FLOOR) {
+                map->tiles[cell] = tile;
+                return COMMON_SUCCESS;
             }
         }
     }
-    return 0;
+    return 1;
 }
 
 /**
- * @brief Place enemies in random locations on the map
+ * @brief Place a key in a dead end (or any floor if there are no dead ends left)
+ * @param map the map to place the key on
+ * @param rng the random number generator to use
+ * @param dead_ends the remaining dead ends of the map
+ * @param floors the remaining floor cells of the map
+ * @return POPULATE_SUCCESS on success, POPULATE_NO_KEY_POSITION if there is no free cell
  */
-void place_enemies() {
-    for (int i = 0; i < ENEMY_COUNT; i++) {
-        int x;
-        int y;
-
-        // Place enemies in random locations
-        do {
-            x = rand() % (WIDTH - 2) + 1;
-            y = rand() % (HEIGHT - 2) + 1;
-        } while (map[x][y] != FLOOR || is_close_to_enemy(x, y));
-
-        map[x][y] = GOBLIN;
+populate_result_t place_key(map_t* map, rng_t* rng, candidate_list_t* dead_ends, candidate_list_t* floors) {
+    if (place_in_dead_end(map, rng, dead_ends, floors, KEY) != COMMON_SUCCESS) {
+        log_msg(ERROR, "map_populator", "No floor left to place the key on a %d x %d floor", map->width, map->height);
+        return POPULATE_NO_KEY_POSITION;
     }
+    return POPULATE_SUCCESS;
 }
 
 
 /**
- * @brief Place a mana fountain and a life fountain in random dead ends on the map
+ * @brief Mark all cells that are too close to the given enemy or door (based on ENEMY_MIN_DISTANCE).
+ *
+ * A cell (cx, cy) counts as close when the tile lies within [cx - ENEMY_MIN_DISTANCE, cx + ENEMY_MIN_DISTANCE + 1]
+ * on both axes, so the stamped area reaches one cell further to the top and to the left.
+ *
+ * @param map the map the exclusion field belongs to
+ * @param excluded the exclusion field (one byte per cell, 1 if no enemy may be placed there)
+ * @param x the x coordinate of the enemy or door
+ * @param y the y coordinate of the enemy or door
  */
-void place_fountains() {
-    int x;
-    int y;
+void stamp_exclusion(const map_t* map, uint8_t* excluded, const int x, const int y) {
+    const int x_min = x - ENEMY_MIN_DISTANCE - 1 > 0 ? x - ENEMY_MIN_DISTANCE - 1 : 0;
+    const int x_max = x + ENEMY_MIN_DISTANCE < map->width - 1 ? x + ENEMY_MIN_DISTANCE : map->width - 1;
+    const int y_min = y - ENEMY_MIN_DISTANCE - 1 > 0 ? y - ENEMY_MIN_DISTANCE - 1 : 0;
+    const int y_max = y + ENEMY_MIN_DISTANCE < map->height - 1 ? y + ENEMY_MIN_DISTANCE : map->height - 1;
 
-    // place the life fountain in the first dead end found
-    do {
-        x = rand() % (WIDTH - 2) + 1;
-        y = rand() % (HEIGHT - 2) + 1;
-    } while (!is_dead_end(x, y));
+    for (int ny = y_min; ny <= y_max; ny++) {
+        memset(&excluded[ny * map->width + x_min], 1, (size_t) (x_max - x_min + 1));
+    }
+}
 
-    map[x][y] = LIFE_FOUNTAIN;
+/**
+ * @brief Place enemies in random locations on the map
+ *
+ * Every placed enemy is stamped into an exclusion field, so checking whether a cell is too close
+ * to another enemy is a single lookup, independent of the number of enemies.
+ *
+ * @param map the map to place the enemies on
+ * @param rng the random number generator to use
+ * @param floors the remaining floor cells of the map
+ * @param enemy_count the number of enemies to place, fewer are placed if they do not fit
+ * @return POPULATE_SUCCESS on success, POPULATE_FEWER_ENEMIES if not all enemies could be placed,
+ * POPULATE_OUT_OF_MEMORY if the exclusion field could not be allocated
+ */
+populate_result_t place_enemies(map_t* map, rng_t* rng, candidate_list_t* floors, const int enemy_count) {
+    uint8_t* excluded = calloc((size_t) map->width * (size_t) map->height, sizeof(uint8_t));
+    NULL_PTR_HANDLER_RETURN(excluded, POPULATE_OUT_OF_MEMORY, "map_populator", "Failed to allocate the exclusion field");
+
+    // enemies should not wait right behind the start door
+    if (map->start_edge != NO_EDGE) {
+        stamp_exclusion(map, excluded, map->start.dx + directions[map->start_edge].dx, map->start.dy + directions[map->start_edge].dy);
+    }
+
+    int placed = 0;
+    // the drawn cells are parked behind the available ones, a rejected cell stays rejected,
+    // enemies only get closer when more are placed
+    int available = floors->count;
+    while (placed < enemy_count && available > 0) {
+        const int i = rng_range(rng, available);
+        const int cell = floors->cells[i];
+        floors->cells[i] = floors->cells[--available];
+        floors->cells[available] = cell;
+        if (map->tiles[cell] != FLOOR || excluded[cell]) continue;
+
+        map->tiles[cell] = GOBLIN;
+        stamp_exclusion(map, excluded, cell % map->width, cell / map->width);
+        placed++;
+    }
+    free(excluded);
+
+    // the cells that were only too close to an enemy are still free for the items
+    int count = available;
+    for (int i = available; i < floors->count; i++) {
+        if (map->tiles[floors->cells[i]] == FLOOR) floors->cells[count++] = floors->cells[i];
+    }
+    floors->count = count;
+
+    if (placed < enemy_count) {
+        log_msg(INFO, "map_populator", "Only %d of %d enemies fit on a %d x %d floor", placed, enemy_count, map->width, map->height);
+        return POPULATE_FEWER_ENEMIES;
+    }
+    return POPULATE_SUCCESS;
+}
 
-    // place the mana fountain in the first dead end found
-    do {
-        x = rand() % (WIDTH - 2) + 1;
-        y = rand() % (HEIGHT - 2) + 1;
-    } while (!is_dead_end(x, y));
 
-    map[x][y] = MANA_FOUNTAIN;
+/**
+ * @brief Place a mana fountain and a life fountain in random dead ends on the map (or any floor if there are no dead ends left)
+ * @param map the map to place the fountains on
+ * @param rng the random number generator to use
+ * @param dead_ends the remaining dead ends of the map
+ * @param floors the remaining floor cells of the map
+ * @return POPULATE_SUCCESS on success, POPULATE_NO_FOUNTAIN_POSITION if there are not enough free cells
+ */
+populate_result_t place_fountains(map_t* map, rng_t* rng, candidate_list_t* dead_ends, candidate_list_t* floors) {
+    if (place_in_dead_end(map, rng, dead_ends, floors, LIFE_FOUNTAIN) != COMMON_SUCCESS ||
+        place_in_dead_end(map, rng, dead_ends, floors, MANA_FOUNTAIN) != COMMON_SUCCESS) {
+        log_msg(ERROR, "map_populator", "No floor left to place the fountains on a %d x %d floor", map->width, map->height);
+        return POPULATE_NO_FOUNTAIN_POSITION;
+    }
+    return POPULATE_SUCCESS;
 }
 
 
-void populate_map() {
-    place_key();
-    place_enemies();
-    place_fountains();
+populate_result_t populate_map(map_t* map, rng_t* rng, const region_index_t* regions, const int enemy_count) {
+    NULL_PTR_HANDLER_RETURN(map, POPULATE_OUT_OF_MEMORY, "map_populator", "In populate_map given map is NULL");
+
+    candidate_list_t dead_ends = {NULL, 0, 0};
+    candidate_list_t floors = {NULL, 0, 0};
+
+    populate_result_t result = POPULATE_OUT_OF_MEMORY;
+    if (collect_candidates(map, regions, &dead_ends, &floors) == COMMON_SUCCESS) {
+        result = place_key(map, rng, &dead_ends, &floors);
+        // a floor with fewer enemies is still complete, the shortfall is reported after the fountains
+        const populate_result_t enemies = result == POPULATE_SUCCESS ? place_enemies(map, rng, &floors, enemy_count) : result;
+        if (enemies == POPULATE_SUCCESS || enemies == POPULATE_FEWER_ENEMIES) {
+            result = place_fountains(map, rng, &dead_ends, &floors);
+            if (result == POPULATE_SUCCESS) result = enemies;
+        } else {
+            result = enemies;
+        }
+    }
+
+    free(dead_ends.cells);
+    free(floors.cells);
+    return result;
 }
@@ -5,9 +5,34 @@
 #ifndef MAP_POPULATOR_H
 #define MAP_POPULATOR_H
 
+#include "../random/rng.h"
+#include "map.h"
+#include "map_regions.h"
+
+typedef enum {
+    POPULATE_SUCCESS = 0,
+    POPULATE_NO_KEY_POSITION,     // no floor left for the key
+    POPULATE_FEWER_ENEMIES,       // the floor is complete, but not all enemies were far enough apart to fit
+    POPULATE_NO_FOUNTAIN_POSITION,// no floor left for the fountains
+    POPULATE_OUT_OF_MEMORY        // the candidate lists could not be allocated
+} populate_result_t;
+
 /**
- * @breif Populates the map with a key, enemies, and fountains
+ * @brief Populates the map with a key, enemies, and fountains
+ *
+ * All candidate cells are collected in one scan over the map and then drawn without
+ * replacement, so the cost is linear in the number of cells and an impossible placement
+ * is detected instead of searching forever. With a region index only cells that can be
+ * reached from the start are used, so the key and the fountains can always be reached.
+ * Small floors may not have space for all enemies, as many as fit are placed then.
+ *
+ * @param map The generated map to populate
+ * @param rng The random number generator to place the items with
+ * @param regions The region index of the map, NULL to use every floor cell
+ * @param enemy_count The number of enemies to place (ENEMY_COUNT for a normal floor)
+ * @return POPULATE_SUCCESS on success, POPULATE_FEWER_ENEMIES if the map is populated with fewer enemies,
+ * otherwise the reason why the map could not be populated
  */
-void populate_map();
+populate_result_t populate_map(map_t* map, rng_t* rng, const region_index_t* regions, int enemy_count);
 
 #endif//MAP_POPULATOR_H
@@ -0,0 +1,188 @@
+/**
+ * @file map_regions.c
+ * @brief Implements the connectivity index of a floor.
+ */
+#include "map_regions.h"
+
+#include "../logging/logger.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define REGION_INITIAL_CAPACITY 64
+#define PARENT_INITIAL_CAPACITY 1024
+
+/**
+ * @brief The union find forest of the provisional labels of the first pass.
+ *
+ * A parent always has a smaller label than its children, so the roots are found in scan order.
+ */
+typedef struct {
+    int* parents;
+    int count;// the number of provisional labels, the labels are 1 to count
+    int capacity;
+} label_forest_t;
+
+/**
+ * @brief Add a new provisional label to the forest, the forest grows as needed.
+ * @param forest the forest to add the label to
+ * @return the new label, NO_REGION if the forest could not grow
+ */
+int add_provisional_label(label_forest_t* forest) {
+    if (forest->count + 1 == forest->capacity) {
+        const int capacity = forest->capacity * 2;
+        int* parents = realloc(forest->parents, (size_t) capacity * sizeof(int));
+        NULL_PTR_HANDLER_RETURN(parents, NO_REGION, "map_regions", "Failed to grow the label forest to %d labels", capacity);
+        forest->parents = parents;
+        forest->capacity = capacity;
+    }
+    const int label = ++forest->count;
+    forest->parents[label] = label;
+    return label;
+}
+
+/**
+ * @brief Find the root of the given label, halving the path on the way.
+ * @param forest the forest to search in
+ * @param label the label to find the root of
+ * @return the root label
+ */
+int find_root(const label_forest_t* forest, int label) {
+    while (forest->parents[label] != label) {
+        forest->parents[label] = forest->parents[forest->parents[label]];
+        label = forest->parents[label];
+    }
+    return label;
+}
+
+/**
+ * @brief Merge the trees of both labels, the smaller root becomes the parent.
+ * @param forest the forest to merge in
+ * @param first the first label
+ * @param second the second label
+ */
+void merge_labels(const label_forest_t* forest, const int first, const int second) {
+    const int first_root = find_root(forest, first);
+    const int second_root = find_root(forest, second);
+    if (first_root < second_root) {
+        forest->parents[second_root] = first_root;
+    } else if (second_root < first_root) {
+        forest->parents[first_root] = second_root;
+    }
+}
+
+/**
+ * @brief First pass: give every cell the label of its left or upper neighbour or a new one and merge both.
+ * @param index the index to store the provisional labels in
+ * @param map the map to label
+ * @param forest the forest to collect the provisional labels in
+ * @return COMMON_SUCCESS on success, a non-zero value if the forest could not grow
+ */
+int label_provisionally(region_index_t* index, const map_t* map, label_forest_t* forest) {
+    for (int y = 0; y < map->height; y++) {
+        const map_tile_t* row = &MAP_TILE(map, 0, y);
+        int* labels = &REGION_AT(index, 0, y);
+        const int* above = y > 0 ? labels - map->width : NULL;
+
+        for (int x = 0; x < map->width; x++) {
+            if (row[x] == WALL) {
+                labels[x] = NO_REGION;
+                continue;
+            }
+            const int up = above != NULL ? above[x] : NO_REGION;
+            const int left = x > 0 ? labels[x - 1] : NO_REGION;
+            if (up == NO_REGION && left == NO_REGION) {
+                labels[x] = add_provisional_label(forest);
+                if (labels[x] == NO_REGION) return 1;
+            } else if (up == NO_REGION || left == NO_REGION) {
+                labels[x] = up != NO_REGION ? up : left;
+            } else {
+                if (up != left) merge_labels(forest, up, left);
+                labels[x] = left;
+            }
+        }
+    }
+    return COMMON_SUCCESS;
+}
+
+region_index_t* init_region_index(const int width, const int height) {
+    region_index_t* index = malloc(sizeof(region_index_t));
+    NULL_PTR_HANDLER_RETURN(index, NULL, "map_regions", "Failed to allocate memory for the region index");
+
+    index->labels = malloc((size_t) width * (size_t) height * sizeof(int));
+    index->sizes = malloc(REGION_INITIAL_CAPACITY * sizeof(int));
+    if (index->labels == NULL || index->sizes == NULL) {
+        log_msg(ERROR, "map_regions", "Failed to allocate the region index for a %d x %d floor", width, height);
+        free(index->labels);
+        free(index->sizes);
+        free(index);
+        return NULL;
+    }
+    index->width = width;
+    index->height = height;
+    index->region_count = 0;
+    index->capacity = REGION_INITIAL_CAPACITY;
+    return index;
+}
+
+void free_region_index(region_index_t* index) {
+    if (index == NULL) return;
+    free(index->labels);
+    free(index->sizes);
+    free(index);
+}
+
+int build_region_index(region_index_t* index, const map_t* map) {
+    NULL_PTR_HANDLER_RETURN(index, 1, "map_regions", "In build_region_index given index is NULL");
+    NULL_PTR_HANDLER_RETURN(map, 1, "map_regions", "In build_region_index given map is NULL");
+    CHECK_ARG_RETURN(index->width != map->width || index->height != map->height, 1, "map_regions",
+                     "Region index of %d x %d does not fit a %d x %d floor", index->width, index->height, map->width, map->height);
+
+    label_forest_t forest = {malloc(PARENT_INITIAL_CAPACITY * sizeof(int)), 0, PARENT_INITIAL_CAPACITY};
+    NULL_PTR_HANDLER_RETURN(forest.parents, 1, "map_regions", "Failed to allocate the label forest");
+    if (label_provisionally(index, map, &forest) != COMMON_SUCCESS) {
+        free(forest.parents);
+        return 1;
+    }
+
+    // number the roots in scan order, the parent of a label is smaller and therefore already numbered
+    int region_count = 0;
+    for (int label = 1; label <= forest.count; label++) {
+        const int parent = forest.parents[label];
+        forest.parents[label] = parent == label ? ++region_count : forest.parents[parent];
+    }
+
+    if (region_count + 1 > index->capacity) {
+        int* sizes = realloc(index->sizes, (size_t) (region_count + 1) * sizeof(int));
+        if (sizes == NULL) {
+            log_msg(ERROR, "map_regions", "Failed to grow the region sizes to %d regions", region_count);
+            free(forest.parents);
+            return 1;
+        }
+        index->sizes = sizes;
+        index->capacity = region_count + 1;
+    }
+    memset(index->sizes, 0, (size_t) (region_count + 1) * sizeof(int));
+    index->region_count = region_count;
+
+    // second pass: replace the provisional labels by the final ones
+    const int cells = map->width * map->height;
+    forest.parents[NO_REGION] = NO_REGION;
+    for (int cell = 0; cell < cells; cell++) {
+        const int region = forest.parents[index->labels[cell]];
+        index->labels[cell] = region;
+        index->sizes[region]++;
+    }
+    free(forest.parents);
+    return COMMON_SUCCESS;
+}
+
+int get_start_region(const region_index_t* index, const map_t* map) {
+    if (map->start_edge == NO_EDGE) return NO_REGION;
+    return REGION_AT(index, map->start.dx, map->start.dy);
+}
+
+int is_in_start_region(const region_index_t* index, const map_t* map, const int x, const int y) {
+    const int start_region = get_start_region(index, map);
+    return start_region != NO_REGION && REGION_AT(index, x, y) == start_region;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file map_regions.h
+ * @brief Exposes the connectivity index of a floor (which cells can reach each other).
+ */
+#ifndef MAP_REGIONS_H
+#define MAP_REGIONS_H
+
+#include "map.h"
+
+#define NO_REGION 0// the label of walls
+
+/**
+ * @brief Labels the connected regions of a floor.
+ *
+ * Every cell that is not a wall belongs to exactly one region, two cells share a label
+ * exactly if one can be reached from the other. The labels are stored row-major like the tiles.
+ */
+typedef struct {
+    int width;
+    int height;
+    int* labels;     // the region of every cell, NO_REGION for walls
+    int* sizes;      // the number of cells of every region, indexed by label (sizes[NO_REGION] counts the walls)
+    int region_count;// the number of regions, the labels are 1 to region_count
+    int capacity;    // the number of entries sizes can hold
+} region_index_t;
+
+/**
+ * @brief Access the region label at the given coordinates of a region_index_t.
+ */
+#define REGION_AT(index, x, y) ((index)->labels[(y) * (index)->width + (x)])
+
+/**
+ * @brief Allocates an empty region index for floors of the given size.
+ *
+ * @param width The width of the floors to index
+ * @param height The height of the floors to index
+ * @return The pointer to the new index, or NULL if the allocation failed.
+ * The index must be freed with free_region_index().
+ */
+region_index_t* init_region_index(int width, int height);
+
+/**
+ * @brief Frees the given region index.
+ *
+ * @param index The index to free, NULL is ignored.
+ */
+void free_region_index(region_index_t* index);
+
+/**
+ * @brief Labels the regions of the given map with a two pass union find.
+ *
+ * The first pass joins every cell with its left and upper neighbour, the second pass replaces
+ * the provisional labels by the final ones. Both passes read the map row by row, so the cost is
+ * linear in the number of cells. The regions are numbered in scan order and the index must have
+ * the same size as the map.
+ *
+ * @param index The index to fill, previous labels are overwritten
+ * @param map The map to label
+ * @return COMMON_SUCCESS on success, a non-zero value if the label forest could not grow
+ */
+int build_region_index(region_index_t* index, const map_t* map);
+
+/**
+ * @brief Returns the region of the start position of the indexed map.
+ *
+ * @param index The built region index
+ * @param map The indexed map
+ * @return The label of the start region, NO_REGION if the map has no start
+ */
+int get_start_region(const region_index_t* index, const map_t* map);
+
+/**
+ * @brief Checks whether the given cell can be reached from the start position of the map.
+ *
+ * @param index The built region index
+ * @param map The indexed map
+ * @param x The x coordinate of the cell
+ * @param y The y coordinate of the cell
+ * @return 1 if the cell is in the start region, 0 otherwise
+ */
+int is_in_start_region(const region_index_t* index, const map_t* map, int x, int y);
+
+#endif//MAP_REGIONS_H
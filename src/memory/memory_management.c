@@ -6,6 +6,114 @@
 
 #include "../logging/logger.h"
 
+void memory_size_class(const size_t size, int* size_class, int* subclass) {
+    if (size < MEMORY_SUBCLASSES) {
+        // the small sizes get one list each
+        *size_class = 0;
+        *subclass = (int) size;
+        return;
+    }
+    const int top_bit = 63 - __builtin_clzll((unsigned long long) size);
+    *size_class = top_bit - MEMORY_SUBCLASS_BITS + 1;
+    *subclass = (int) ((size >> (top_bit - MEMORY_SUBCLASS_BITS)) ^ MEMORY_SUBCLASSES);
+}
+
+/**
+ * @brief Adds a free block to the front of the free list of its size subclass.
+ * @param pool the pool of the block
+ * @param block the free block
+ */
+static void insert_free_block(memory_pool_t* pool, memory_block_t* block) {
+    int size_class;
+    int subclass;
+    memory_size_class(block->size, &size_class, &subclass);
+    block->prev_free = NULL;
+    block->next_free = pool->free_lists[size_class][subclass];
+    if (block->next_free != NULL) block->next_free->prev_free = block;
+    pool->free_lists[size_class][subclass] = block;
+    pool->free_classes |= 1ULL << size_class;
+    pool->free_subclasses[size_class] |= 1U << subclass;
+}
+
+/**
+ * @brief Takes a free block out of the free list of its size subclass.
+ * @param pool the pool of the block
+ * @param block the free block, its size must not have changed since it was inserted
+ */
+static void remove_free_block(memory_pool_t* pool, const memory_block_t* block) {
+    int size_class;
+    int subclass;
+    memory_size_class(block->size, &size_class, &subclass);
+    if (block->prev_free != NULL) {
+        block->prev_free->next_free = block->next_free;
+    } else {
+        pool->free_lists[size_class][subclass] = block->next_free;
+    }
+    if (block->next_free != NULL) block->next_free->prev_free = block->prev_free;
+    if (pool->free_lists[size_class][subclass] == NULL) {
+        pool->free_subclasses[size_class] &= ~(1U << subclass);
+        if (pool->free_subclasses[size_class] == 0) pool->free_classes &= ~(1ULL << size_class);
+    }
+}
+
+/**
+ * @brief Finds a free block that is large enough.
+ *
+ * The first block of the own subclass is tried first, so freed blocks are reused by requests of the
+ * same size. Otherwise the size is rounded up to the next subclass, every block of that subclass and
+ * above fits, and the smallest non-empty one is found with two bit scans. Only if there is none,
+ * the rest of the own subclass is searched, so no request fails while a block would fit.
+ *
+ * @param pool the pool to search
+ * @param size the size of the memory to allocate
+ * @return the free block, or NULL if no free block is large enough
+ */
+static memory_block_t* find_free_block(const memory_pool_t* pool, const size_t size) {
+    int size_class;
+    int subclass;
+    memory_size_class(size, &size_class, &subclass);
+    memory_block_t* own = pool->free_lists[size_class][subclass];
+    if (own != NULL && own->size >= size) return own;
+
+    // the smallest size of a subclass is a multiple of its width, rounding up to it skips the own subclass
+    size_t rounded = size;
+    if (size >= MEMORY_SUBCLASSES) {
+        const int top_bit = 63 - __builtin_clzll((unsigned long long) size);
+        rounded = size + ((size_t) 1 << (top_bit - MEMORY_SUBCLASS_BITS)) - 1;
+    }
+    if (rounded >= size) {
+        int fit_class;
+        int fit_subclass;
+        memory_size_class(rounded, &fit_class, &fit_subclass);
+        uint32_t subclasses = pool->free_subclasses[fit_class] & (~0U << fit_subclass);
+        if (subclasses == 0 && fit_class + 1 < MEMORY_SIZE_CLASSES) {
+            const uint64_t classes = pool->free_classes & (~0ULL << (fit_class + 1));
+            if (classes != 0) {
+                fit_class = __builtin_ctzll(classes);
+                subclasses = pool->free_subclasses[fit_class];
+            }
+        }
+        if (subclasses != 0) return pool->free_lists[fit_class][__builtin_ctz(subclasses)];
+    }
+
+    for (memory_block_t* block = own; block != NULL; block = block->next_free) {
+        if (block->size >= size) return block;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Merges a free block with the free block that physically follows it.
+ * Both blocks must already be taken out of the free lists.
+ * @param block the free block, its next block must be free
+ */
+static void merge_next_block(memory_block_t* block) {
+    const memory_block_t* next = block->next;
+    block->size += sizeof(memory_block_t) + next->size;
+    block->next = next->next;// link to the block after the merged one
+    if (block->next != NULL) block->next->prev = block;
+}
+
 /**
  * @brief Initialize a memory pool of the given size.
  * @param size the size of the memory pool to initialize,
@@ -36,12 +144,23 @@ memory_pool_t* init_memory_pool(size_t size) {
     pool->first->size = size - sizeof(memory_block_t);
     pool->first->active = 0; // mark the block as free
     pool->first->next = NULL;// no next block
+    pool->first->prev = NULL;// no previous block
+
+    for (int i = 0; i < MEMORY_SIZE_CLASSES; i++) {
+        for (int j = 0; j < MEMORY_SUBCLASSES; j++) {
+            pool->free_lists[i][j] = NULL;
+        }
+        pool->free_subclasses[i] = 0;
+    }
+    pool->free_classes = 0;
+    insert_free_block(pool, pool->first);
 
     return pool;
 }
 
 /**
  * @brief Allocates memory on the given memory pool.
+ * Takes a free block from the free lists, see find_free_block.
  * If the remaining memory space is lager enough, creates a new unused block for the remaining memory.
  *
  * @param pool the pool to allocate memory from
@@ -49,42 +168,41 @@ memory_pool_t* init_memory_pool(size_t size) {
  * @return the pointer to the reserved memory space, or NULL if there is no free space on the pool
  */
 void* memory_pool_alloc(memory_pool_t* pool, size_t size) {
-    memory_block_t* current = pool->first;
-
-    while (current) {
-        if (!current->active && current->size >= size) {
-            // found a free block that is large enough
-
-            const size_t remaining = current->size - size;
-            if (remaining > MIN_MEMORY_BLOCK_SIZE) {
-                // remaining is large enough
-                // create a new block for the remaining memory
-                memory_block_t* new_block = (memory_block_t*) ((char*) current + sizeof(memory_block_t) + size);
+    memory_block_t* current = find_free_block(pool, size);
+    if (current == NULL) {
+        log_msg(ERROR, "Memory", "No free block found for allocation");
+        return NULL;
+    }
+    remove_free_block(pool, current);
 
-                new_block->size = remaining - sizeof(memory_block_t);
-                new_block->active = 0;          // mark the new block as free
-                new_block->next = current->next;// link to the next block
+    const size_t remaining = current->size - size;
+    if (remaining > MIN_MEMORY_BLOCK_SIZE) {
+        // remaining is large enough
+        // create a new block for the remaining memory
+        memory_block_t* new_block = (memory_block_t*) ((char*) current + sizeof(memory_block_t) + size);
 
-                current->size = size;// set the size of the current block
+        new_block->size = remaining - sizeof(memory_block_t);
+        new_block->active = 0;          // mark the new block as free
+        new_block->next = current->next;// link to the next block
+        new_block->prev = current;
+        if (new_block->next != NULL) new_block->next->prev = new_block;
 
-                current->next = new_block;// link to the new block
-            }
+        current->size = size;// set the size of the current block
 
-            //the remaining memory space is too small, so the current block will be used entirely
-            current->active = 1;
-            return (void*) (current + 1);// return pointer to user data
-        }
-        current = current->next;// move to the next block
+        current->next = new_block;// link to the new block
+        insert_free_block(pool, new_block);
     }
 
-    log_msg(ERROR, "Memory", "No free block found for allocation");
-    return NULL;
+    //the remaining memory space is too small, so the current block will be used entirely
+    current->active = 1;
+    return (void*) (current + 1);// return pointer to user data
 }
 
 /**
  * @brief Sets the given data pointer to not active in the given memory pool.
  * But first checks if the pointer is contained in the memory pool.
- * If needed it will defragment the memory pool and merge free blocks.
+ * A free neighbour is merged right away, so two free blocks never lie next to each other and only the
+ * neighbours of the freed block need to be looked at.
  *
  * @param pool the pool to free memory from
  * @param ptr the pointer to the memory to free
@@ -100,19 +218,23 @@ void memory_pool_free(memory_pool_t* pool, void* ptr) {
         log_msg(ERROR, "Memory", "Pointer is not in the memory pool");
         return;
     }
+    if (!block->active) {
+        log_msg(ERROR, "Memory", "Pointer was already freed");
+        return;
+    }
     block->active = 0;
 
-    // when needed, defragmentation of the memory blocks
-    memory_block_t* current = pool->first;
-    while (current && current->next) {
-        if (!current->active && !current->next->active) {
-            // merge with the next block
-            current->size += sizeof(memory_block_t) + current->next->size;
-            current->next = current->next->next;// link to the next block
-        } else {
-            current = current->next;// move to the next block
-        }
+    // the merged block may belong to another size class, so it is inserted last
+    if (block->next != NULL && !block->next->active) {
+        remove_free_block(pool, block->next);
+        merge_next_block(block);
+    }
+    if (block->prev != NULL && !block->prev->active) {
+        block = block->prev;
+        remove_free_block(pool, block);
+        merge_next_block(block);
     }
+    insert_free_block(pool, block);
 }
 
 void shutdown_memory_pool(memory_pool_t* pool) {
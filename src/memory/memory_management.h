@@ -5,23 +5,40 @@
 #ifndef MEMORY_MANAGEMENT_H
 #define MEMORY_MANAGEMENT_H
 
+#include <stdint.h>
 #include <stdlib.h>
 
 #define STANDARD_MEMORY_POOL_SIZE (8 * 1024 * 1024)        // 8MB
 #define MIN_MEMORY_POOL_SIZE (1024 * 1024)                 // 1MB
 #define MIN_MEMORY_BLOCK_SIZE (sizeof(memory_block_t) + 16)// 16 bytes for min user data
+#define MEMORY_SIZE_CLASSES 64                             // first level: one size class per power of two of the block size
+#define MEMORY_SUBCLASS_BITS 4
+#define MEMORY_SUBCLASSES (1 << MEMORY_SUBCLASS_BITS)// second level: every size class split into 16 equal ranges
 
+/**
+ * @brief The header in front of every block of a pool.
+ *
+ * Besides the size and the link to the next block, the header holds the link to the previous
+ * block and the links of the free lists, so it takes 48 instead of 24 bytes on 64-bit systems.
+ * MIN_MEMORY_BLOCK_SIZE grows with it.
+ */
 typedef struct memory_block_t {
-    size_t size;                // size of the block (without the header)
-    int active;                 // 1 if the block is in use, 0 if it is free
-    struct memory_block_t* next;// pointer to the next block
+    size_t size;                     // size of the block (without the header)
+    int active;                      // 1 if the block is in use, 0 if it is free
+    struct memory_block_t* next;     // pointer to the next block
+    struct memory_block_t* prev;     // pointer to the previous block, so a freed block finds both neighbours
+    struct memory_block_t* next_free;// the next free block of the same size subclass, only used while free
+    struct memory_block_t* prev_free;// the previous free block of the same size subclass, only used while free
     //here lays the user data
 } memory_block_t;
 
 typedef struct {
     size_t pool_size;// size of the memory pool
     void* memory;
-    memory_block_t* first;// pointer to the first block
+    memory_block_t* first;                                             // pointer to the first block
+    memory_block_t* free_lists[MEMORY_SIZE_CLASSES][MEMORY_SUBCLASSES];// the free blocks by size class and subclass, see memory_size_class
+    uint64_t free_classes;                                             // bit c is set while a list of class c is not empty
+    uint32_t free_subclasses[MEMORY_SIZE_CLASSES];                     // bit s of entry c is set while free_lists[c][s] is not empty
 } memory_pool_t;
 
 
@@ -37,10 +54,27 @@ typedef struct {
  */
 memory_pool_t* init_memory_pool(size_t size);
 /**
- * @brief Allocate a memory pool.
+ * @brief Computes the free list of a block size, the two levels of a TLSF allocator.
+ *
+ * The sizes below MEMORY_SUBCLASSES have one list each in class 0. Every larger power of two is a
+ * size class, split into MEMORY_SUBCLASSES subclasses of equal width by the bits below the highest
+ * set bit.
+ *
+ * @param size The size of the block.
+ * @param size_class Set to the size class.
+ * @param subclass Set to the subclass within the size class.
+ */
+void memory_size_class(size_t size, int* size_class, int* subclass);
+
+/**
+ * @brief Allocate memory on a memory pool.
+ *
+ * The free blocks are kept in one list per size subclass, so a free block is found without walking
+ * the blocks of the pool.
  *
- * @param pool The memory pool to allocate.
- * @param size The size of the memory pool.
+ * @param pool The memory pool to allocate on.
+ * @param size The size of the memory to allocate.
+ * @return A pointer to the allocated memory, or NULL if no free block is large enough.
  */
 void* memory_pool_alloc(memory_pool_t* pool, size_t size);
 /**
@@ -11,7 +11,7 @@
 #include "local/language_menu_local.h"
 
 int init_language_menu() {
-    language_menu_strings = (char**) malloc(sizeof(char*) * MAX_LANGUAGE_MENU_STRINGS);
+    language_menu_strings = (const char**) malloc(sizeof(char*) * MAX_LANGUAGE_MENU_STRINGS);
     RETURN_WHEN_NULL(language_menu_strings, 1, "Language Menu", "Failed to allocate memory for language menu strings.");
 
     for (int i = 0; i < MAX_LANGUAGE_MENU_STRINGS; i++) {
@@ -83,11 +83,6 @@ menu_result_t show_language_menu() {
 
 void shutdown_language_menu() {
     if (language_menu_strings != NULL) {
-        for (int i = 0; i < MAX_LANGUAGE_MENU_STRINGS; i++) {
-            if (language_menu_strings[i] != NULL) {
-                free(language_menu_strings[i]);
-            }
-        }
         free(language_menu_strings);
     }
 }
@@ -8,15 +8,9 @@
 
 #include <stdlib.h>
 
-char** language_menu_strings = NULL;
+const char** language_menu_strings = NULL;
 
 void update_language_menu_local(void) {
-    for (int i = 0; i < MAX_LANGUAGE_MENU_STRINGS; i++) {
-        if (language_menu_strings[i] != NULL) {
-            free(language_menu_strings[i]);
-        }
-    }
-
-    language_menu_strings[LANGUAGE_ENGLISH] = get_local_string("ENGLISH");
-    language_menu_strings[LANGUAGE_GERMAN] = get_local_string("GERMAN");
+    language_menu_strings[LANGUAGE_ENGLISH] = get_local_text_by_id(LOCAL_ENGLISH);
+    language_menu_strings[LANGUAGE_GERMAN] = get_local_text_by_id(LOCAL_GERMAN);
 }
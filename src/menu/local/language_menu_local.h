@@ -12,7 +12,7 @@ enum language_menu_index {
     MAX_LANGUAGE_MENU_STRINGS
 };
 
-extern char** language_menu_strings;
+extern const char** language_menu_strings;
 
 /**
  * @brief Updates the localized strings for the language menu.
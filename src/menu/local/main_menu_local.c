@@ -8,21 +8,15 @@
 
 #include <stdlib.h>
 
-char** main_menu_strings = NULL;
+const char** main_menu_strings = NULL;
 
 void update_main_menu_local(void) {
-    for (int i = 0; i < MAX_MAIN_MENU_STRINGS; i++) {
-        if (main_menu_strings[i] != NULL) {
-            free(main_menu_strings[i]);
-        }
-    }
-
-    main_menu_strings[NEW_GAME_STR] = get_local_string("MAIN_MENU.NEW_GAME");
-    main_menu_strings[CONTINUE_STR] = get_local_string("MAIN_MENU.CONTINUE");
-    main_menu_strings[SAVE_GAME_STR] = get_local_string("MAIN_MENU.SAVE_GAME");
-    main_menu_strings[LOAD_GAME_STR] = get_local_string("MAIN_MENU.LOAD_GAME");
-    main_menu_strings[CHANGE_LANGUAGE_STR] = get_local_string("MAIN_MENU.CHANGE_LANGUAGE");
-    main_menu_strings[EXIT_STR] = get_local_string("MAIN_MENU.EXIT");
-    main_menu_strings[QUESTION_CONTINUE] = get_local_string("MAIN_MENU.QUESTION.CONTINUE");
-    main_menu_strings[QUESTION_EXIT] = get_local_string("MAIN_MENU.QUESTION.EXIT");
+    main_menu_strings[NEW_GAME_STR] = get_local_text_by_id(LOCAL_MAIN_MENU_NEW_GAME);
+    main_menu_strings[CONTINUE_STR] = get_local_text_by_id(LOCAL_MAIN_MENU_CONTINUE);
+    main_menu_strings[SAVE_GAME_STR] = get_local_text_by_id(LOCAL_MAIN_MENU_SAVE_GAME);
+    main_menu_strings[LOAD_GAME_STR] = get_local_text_by_id(LOCAL_MAIN_MENU_LOAD_GAME);
+    main_menu_strings[CHANGE_LANGUAGE_STR] = get_local_text_by_id(LOCAL_MAIN_MENU_CHANGE_LANGUAGE);
+    main_menu_strings[EXIT_STR] = get_local_text_by_id(LOCAL_MAIN_MENU_EXIT);
+    main_menu_strings[QUESTION_CONTINUE] = get_local_text_by_id(LOCAL_MAIN_MENU_QUESTION_CONTINUE);
+    main_menu_strings[QUESTION_EXIT] = get_local_text_by_id(LOCAL_MAIN_MENU_QUESTION_EXIT);
 }
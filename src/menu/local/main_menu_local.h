@@ -18,7 +18,7 @@ enum main_menu_index {
     MAX_MAIN_MENU_STRINGS
 };
 
-extern char** main_menu_strings;
+extern const char** main_menu_strings;
 
 /**
  * @brief Updates the localized strings for the main menu.
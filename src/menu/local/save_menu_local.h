@@ -20,7 +20,7 @@ enum save_menu_index {
     MAX_SAVE_MENU_STRINGS
 };
 
-extern char** save_menu_strings;
+extern const char** save_menu_strings;
 
 /**
  * @brief Updates the localized strings for the save menu.
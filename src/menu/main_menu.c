@@ -27,7 +27,7 @@ bool menu_active;
 menu_result_t active_menu_state;
 
 int init_main_menu() {
-    main_menu_strings = (char**) malloc(sizeof(char*) * MAX_MAIN_MENU_STRINGS);
+    main_menu_strings = (const char**) malloc(sizeof(char*) * MAX_MAIN_MENU_STRINGS);
     RETURN_WHEN_NULL(main_menu_strings, 1, "Main Menu", "Failed to allocate memory for main menu strings.");
 
     for (int i = 0; i < MAX_MAIN_MENU_STRINGS; i++) {
@@ -160,11 +160,6 @@ void select_menu_option(const int selected_index, const bool game_in_progress) {
 
 void shutdown_main_menu(void) {
     if (main_menu_strings != NULL) {
-        for (int i = 0; i < MAX_MAIN_MENU_STRINGS; i++) {
-            if (main_menu_strings[i] != NULL) {
-                free(main_menu_strings[i]);
-            }
-        }
         free(main_menu_strings);
     }
 }
@@ -19,9 +19,7 @@ void draw_menu(const char** menu_options, int menu_count, int selected_index) {
     clear_screen();
 
     // Draw title
-    char* title = get_local_string("LAUNCH.TITLE");
-    print_text(MENU_START_Y, MENU_START_X, title, RED_TEXT_COLORS);
-    free(title);
+    print_text(MENU_START_Y, MENU_START_X, get_local_text_by_id(LOCAL_LAUNCH_TITLE), RED_TEXT_COLORS);
 
     // Draw menu options
     int y = MENU_START_Y + 3;
@@ -47,9 +45,7 @@ bool show_confirmation(const char* message) {
     // Print confirmation messages
     print_text_default(MENU_START_Y, MENU_START_X, save_menu_strings[WARNING_LOST_PROGRESS]);
     print_text_default(MENU_START_Y + 2, MENU_START_X, message);
-    char* yes_no = get_local_string("CONFIRM.YES_NO");
-    print_text_default(MENU_START_Y + 4, MENU_START_X, yes_no);
-    free(yes_no);
+    print_text_default(MENU_START_Y + 4, MENU_START_X, get_local_text_by_id(LOCAL_CONFIRM_YES_NO));
 
     // Render the frame
     render_frame();
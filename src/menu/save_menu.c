@@ -209,11 +209,6 @@ menu_result_t show_load_game_menu(bool game_in_progress) {
 
 void shutdown_save_menu(void) {
     if (save_menu_strings != NULL) {
-        for (int i = 0; i < MAX_SAVE_MENU_STRINGS; i++) {
-            if (save_menu_strings[i] != NULL) {
-                free(save_menu_strings[i]);
-            }
-        }
         free(save_menu_strings);
     }
 }
@@ -0,0 +1,86 @@
+/**
+ * @file rng.c
+ * @brief Implements a xoshiro256** pseudo random number generator.
+ */
+#include "rng.h"
+
+#include <stdatomic.h>
+#include <time.h>
+
+/**
+ * @brief One step of the splitmix64 generator, used to expand seeds.
+ * @param x pointer to the splitmix64 state
+ * @return the next splitmix64 value
+ */
+static uint64_t splitmix64(uint64_t* x) {
+    uint64_t z = (*x += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Rotates the given value to the left.
+ * @param x the value to rotate
+ * @param k the number of bits to rotate by
+ * @return the rotated value
+ */
+static uint64_t rotl(const uint64_t x, const int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+void init_rng(rng_t* rng, uint64_t seed) {
+    for (int i = 0; i < 4; i++) {
+        rng->state[i] = splitmix64(&seed);
+    }
+}
+
+uint64_t rng_next(rng_t* rng) {
+    uint64_t* s = rng->state;
+    const uint64_t result = rotl(s[1] * 5, 7) * 9;
+    const uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+
+    return result;
+}
+
+int rng_range(rng_t* rng, const int bound) {
+    if (bound <= 0) return 0;
+
+    // Lemire's multiply-shift with rejection, avoids the modulo bias and the division in the common case
+    const uint32_t range = (uint32_t) bound;
+    uint64_t product = (rng_next(rng) >> 32) * range;
+    uint32_t low = (uint32_t) product;
+    if (low < range) {
+        const uint32_t threshold = -range % range;
+        while (low < threshold) {
+            product = (rng_next(rng) >> 32) * range;
+            low = (uint32_t) product;
+        }
+    }
+    return (int) (product >> 32);
+}
+
+uint64_t generate_seed(void) {
+    // makes seeds created within the same second differ
+    static atomic_uint_fast64_t counter = 0;
+
+    uint64_t seed = (uint64_t) time(NULL);
+    // XOR with address of a stack variable and the used cpu time to add more entropy
+    int stack_var;
+    seed ^= (uint64_t) (uintptr_t) &stack_var;
+    seed ^= (uint64_t) clock() << 32;
+    seed += atomic_fetch_add(&counter, 1) * 0x9e3779b97f4a7c15ULL;
+    return splitmix64(&seed);
+}
+
+uint64_t derive_seed(const uint64_t seed, const uint64_t stream) {
+    uint64_t state = seed ^ (stream * 0xd1b54a32d192ed03ULL);
+    return splitmix64(&state);
+}
@@ -0,0 +1,67 @@
+/**
+ * @file rng.h
+ * @brief Exposes a small, seedable pseudo random number generator.
+ *
+ * Unlike rand(), every generator keeps its own state, so generators can be used on
+ * several threads at once and the same seed always results in the same sequence.
+ */
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+/**
+ * @brief State of a xoshiro256** generator.
+ */
+typedef struct {
+    uint64_t state[4];
+} rng_t;
+
+/**
+ * @brief Initializes the generator with the given seed.
+ *
+ * The seed is expanded with splitmix64, so any value (including 0) is a valid seed.
+ *
+ * @param rng The generator to initialize
+ * @param seed The seed to start from
+ */
+void init_rng(rng_t* rng, uint64_t seed);
+
+/**
+ * @brief Returns the next 64 random bits of the generator.
+ *
+ * @param rng The generator to draw from
+ * @return The next random value
+ */
+uint64_t rng_next(rng_t* rng);
+
+/**
+ * @brief Returns a uniformly distributed random number in the range [0, bound).
+ *
+ * @param rng The generator to draw from
+ * @param bound The exclusive upper bound, must be greater than 0
+ * @return The random number, 0 if bound is not positive
+ */
+int rng_range(rng_t* rng, int bound);
+
+/**
+ * @brief Creates a seed from the current time and process specific values.
+ *
+ * Use this when a floor does not need to be reproducible.
+ *
+ * @return A new seed
+ */
+uint64_t generate_seed(void);
+
+/**
+ * @brief Derives an independent seed from a base seed and a stream number.
+ *
+ * Useful to give every floor of a game its own seed, derived from one game seed.
+ *
+ * @param seed The base seed
+ * @param stream The stream number (e.g. the floor number)
+ * @return The derived seed
+ */
+uint64_t derive_seed(uint64_t seed, uint64_t stream);
+
+#endif//RNG_H
@@ -28,16 +28,15 @@ enum stats_mode_index {
     MAX_STATS_STRINGS
 };
 
-extern char** stats_mode_strings;
+extern const char** stats_mode_strings;
 
 /**
  * Updates the localized strings used in the stats menu.
  *
  * This function refreshes the strings used to display various statistics
- * or menu titles by retrieving their updated localized values. It first frees
- * any previously allocated strings in the `stats_mode_strings` array and then
- * populates the array with fresh localized strings retrieved from the
- * `get_local_string` function.
+ * or menu titles by pointing the `stats_mode_strings` array to the texts of the
+ * current language, retrieved with the `get_local_text_by_id` function. Nothing
+ * is allocated or freed.
  *
  * @note The function assumes that the `stats_mode_strings` array has
  *       sufficient capacity to hold all the required strings (defined by
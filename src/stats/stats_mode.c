@@ -33,9 +33,9 @@ stats_result_t stats_mode(character_t* player) {
                 4,
                 selected_index, "");
     }
-    // Check for input
+    // Wait for input, the window only changes on input
     input_event_t input_event;
-    if (get_input_nonblocking(&input_event)) {
+    if (get_input_timeout(&input_event, INPUT_IDLE_TIMEOUT_MS)) {
         // Handle input using logical input types
         switch (input_event.type) {
             case INPUT_UP:
@@ -10,6 +10,11 @@ typedef struct {
     void (*func)(void);
 } thread_func_wrapper_t;
 
+typedef struct {
+    void (*func)(void*);
+    void* arg;
+} thread_arg_wrapper_t;
+
 #ifdef _WIN32
     #include <windows.h>
 
@@ -25,21 +30,66 @@ DWORD WINAPI thread_wrapper(LPVOID arg) {
     return 0;
 }
 
-void start_simple_thread(void (*thread_func)(void)) {
+int start_simple_thread(void (*thread_func)(void)) {
     thread_func_wrapper_t* arg = malloc(sizeof(thread_func_wrapper_t));
-    if (!arg) return;
+    if (!arg) return 1;
     arg->func = thread_func;
 
     HANDLE thread = CreateThread(NULL, 0, thread_wrapper, arg, 0, NULL);
     if (thread) {
         CloseHandle(thread);// detach the thread
-    } else {
-        free(arg);
+        return 0;
     }
+    free(arg);
+    return 1;
+}
+
+/**
+ * @brief A wrapper function arround a joinable thread for multi platform thread implementation.
+ *
+ * @param arg The wrapped function and its argument.
+ */
+DWORD WINAPI thread_arg_wrapper(LPVOID arg) {
+    thread_arg_wrapper_t* wrapper_arg = (thread_arg_wrapper_t*) arg;
+    wrapper_arg->func(wrapper_arg->arg);
+    return 0;
+}
+
+struct thread_handle_s {
+    HANDLE thread;
+    thread_arg_wrapper_t wrapper;
+};
+
+thread_handle_t start_thread(void (*thread_func)(void*), void* arg) {
+    thread_handle_t handle = malloc(sizeof(struct thread_handle_s));
+    if (!handle) return NULL;
+    handle->wrapper.func = thread_func;
+    handle->wrapper.arg = arg;
+
+    handle->thread = CreateThread(NULL, 0, thread_arg_wrapper, &handle->wrapper, 0, NULL);
+    if (!handle->thread) {
+        free(handle);
+        return NULL;
+    }
+    return handle;
+}
+
+void join_thread(thread_handle_t thread) {
+    if (!thread) return;
+    WaitForSingleObject(thread->thread, INFINITE);
+    CloseHandle(thread->thread);
+    free(thread);
+}
+
+int get_processor_count(void) {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (int) info.dwNumberOfProcessors : 1;
 }
 
 #else
     #include <pthread.h>
+    #include <unistd.h>
 
 /**
  * @brief A wrapper function arround a thread for multi platform thread implementation.
@@ -53,16 +103,57 @@ void* thread_wrapper(void* arg) {
     return NULL;
 }
 
-void start_simple_thread(void (*thread_func)(void)) {
+int start_simple_thread(void (*thread_func)(void)) {
     pthread_t thread;
     thread_func_wrapper_t* arg = malloc(sizeof(thread_func_wrapper_t));
-    if (!arg) return;// Fehlerbehandlung
+    if (!arg) return 1;// Fehlerbehandlung
     arg->func = thread_func;
 
     if (pthread_create(&thread, NULL, thread_wrapper, arg) == 0) {
         pthread_detach(thread);// Detach den Thread
-    } else {
-        free(arg);// Fehlerbehandlung
+        return 0;
     }
+    free(arg);// Fehlerbehandlung
+    return 1;
+}
+
+/**
+ * @brief A wrapper function arround a joinable thread for multi platform thread implementation.
+ *
+ * @param arg The wrapped function and its argument.
+ */
+void* thread_arg_wrapper(void* arg) {
+    thread_arg_wrapper_t* wrapper_arg = (thread_arg_wrapper_t*) arg;
+    wrapper_arg->func(wrapper_arg->arg);
+    return NULL;
+}
+
+struct thread_handle_s {
+    pthread_t thread;
+    thread_arg_wrapper_t wrapper;
+};
+
+thread_handle_t start_thread(void (*thread_func)(void*), void* arg) {
+    thread_handle_t handle = malloc(sizeof(struct thread_handle_s));
+    if (!handle) return NULL;
+    handle->wrapper.func = thread_func;
+    handle->wrapper.arg = arg;
+
+    if (pthread_create(&handle->thread, NULL, thread_arg_wrapper, &handle->wrapper) != 0) {
+        free(handle);
+        return NULL;
+    }
+    return handle;
+}
+
+void join_thread(thread_handle_t thread) {
+    if (!thread) return;
+    pthread_join(thread->thread, NULL);
+    free(thread);
+}
+
+int get_processor_count(void) {
+    const long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (int) count : 1;
 }
 #endif
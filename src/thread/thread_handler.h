@@ -11,7 +11,36 @@
  * The thread will be detached, so it will run independently.
  *
  * @param thread_func A simple function pointer to the function that will be executed in the thread.
+ * @return 0 if the thread was started, 1 otherwise
  */
-void start_simple_thread(void (*thread_func)(void));
+int start_simple_thread(void (*thread_func)(void));
+
+/**
+ * @brief A thread that must be joined with join_thread().
+ */
+typedef struct thread_handle_s* thread_handle_t;
+
+/**
+ * @brief Starts a new thread that can be joined.
+ *
+ * @param thread_func The function that will be executed in the thread.
+ * @param arg The argument passed to the function.
+ * @return The handle of the thread, or NULL if the thread could not be started.
+ */
+thread_handle_t start_thread(void (*thread_func)(void*), void* arg);
+
+/**
+ * @brief Waits for the given thread to finish and frees its handle.
+ *
+ * @param thread The thread to wait for, NULL is ignored.
+ */
+void join_thread(thread_handle_t thread);
+
+/**
+ * @brief Returns the number of processors available to the process.
+ *
+ * @return The number of processors, at least 1.
+ */
+int get_processor_count(void);
 
 #endif//THREAD_HANDLER_H
@@ -3,10 +3,12 @@
 #include "../src/common.h"
 #include "../src/database/database.h"
 #include "../src/database/game/gamestate_database.h"
+#include "../src/map/map.h"
 
 #include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 // Define the size of the map
 #define WIDTH 2
@@ -131,6 +133,96 @@ void test_save_game_state() {
     db_close(&db_connection);
 }
 
+void test_load_baseline_save() {
+    assert(db_open(&db_connection, "../test/database/test_data.db") == DB_OPEN_STATUS_SUCCESS);
+    assert(db_is_open(&db_connection) == 1);
+
+    // the maps used to be arrays map[width][height], saved as they lay in memory
+    const int width = 11;
+    const int height = 9;
+    int baseline_map[11][9];
+    int baseline_revealed[11][9];
+    for (int x = 0; x < width; x++) {
+        for (int y = 0; y < height; y++) {
+            baseline_map[x][y] = (x + 2 * y) % 5 == 0 ? WALL : FLOOR;
+            baseline_revealed[x][y] = x < 4 ? baseline_map[x][y] : HIDDEN;
+        }
+    }
+    baseline_map[9][1] = EXIT_DOOR;
+    baseline_map[2][7] = KEY;
+    baseline_revealed[2][7] = KEY;
+    char* map_json = arr2D_to_flat_json((int*) baseline_map, width, height);
+    char* revealed_json = arr2D_to_flat_json((int*) baseline_revealed, width, height);
+    assert(map_json != NULL && revealed_json != NULL);
+
+    // insert the rows like a save made before the maps were stored row by row
+    int rc = sqlite3_exec(db_connection.db, "INSERT INTO game_state (GS_SAVEDTIME, GS_NAME) VALUES ('2000-01-01 00:00:00', 'Baseline');", NULL, NULL, NULL);
+    assert(rc == SQLITE_OK);
+    const sqlite3_int64 game_state_id = sqlite3_last_insert_rowid(db_connection.db);
+    sqlite3_stmt* stmt;
+    rc = sqlite3_prepare_v2(db_connection.db, "INSERT INTO map_state (MS_MAP, MS_REVEALED, MS_HEIGHT, MS_WIDTH, MS_GS_ID, MS_FLOOR) VALUES (?, ?, ?, ?, ?, 3);", -1, &stmt, NULL);
+    assert(rc == SQLITE_OK);
+    sqlite3_bind_text(stmt, 1, map_json, -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt, 2, revealed_json, -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int(stmt, 3, height);
+    sqlite3_bind_int(stmt, 4, width);
+    sqlite3_bind_int64(stmt, 5, game_state_id);
+    assert(sqlite3_step(stmt) == SQLITE_DONE);
+    sqlite3_finalize(stmt);
+    rc = sqlite3_prepare_v2(db_connection.db, "INSERT INTO player_state (PS_X, PS_Y, PS_GS_ID) VALUES (2, 7, ?);", -1, &stmt, NULL);
+    assert(rc == SQLITE_OK);
+    sqlite3_bind_int64(stmt, 1, game_state_id);
+    assert(sqlite3_step(stmt) == SQLITE_DONE);
+    sqlite3_finalize(stmt);
+
+    // load it the way the game does
+    int loaded_width;
+    int loaded_height;
+    assert(get_map_dimensions_by_id(&db_connection, (int) game_state_id, &loaded_width, &loaded_height) == 1);
+    assert(loaded_width == width && loaded_height == height);
+    map_t* map = init_map(width, height);
+    assert(map != NULL);
+    map_tile_t tiles[11 * 9];
+    map_tile_t revealed[11 * 9];
+    int floor = 0;
+    rc = get_game_state_by_id(&db_connection, (int) game_state_id, (int*) tiles, (int*) revealed, width, height, &floor, setter);
+    assert(rc == 1);
+    assert(floor == 3);
+    import_save_tiles(map, tiles);
+    import_revealed_tiles(map, revealed);
+
+    // every cell is at its old place
+    assert(MAP_TILE(map, 9, 1) == EXIT_DOOR);
+    assert(MAP_TILE(map, 2, 7) == KEY);
+    for (int x = 0; x < width; x++) {
+        for (int y = 0; y < height; y++) {
+            assert((int) MAP_TILE(map, x, y) == baseline_map[x][y]);
+            assert((int) MAP_REVEALED(map, x, y) == baseline_revealed[x][y]);
+        }
+    }
+
+    // a new save is stored the same way
+    map_tile_t* exported = export_save_tiles(map);
+    assert(exported != NULL);
+    char* exported_json = arr2D_to_flat_json((int*) exported, width, height);
+    assert(exported_json != NULL && strcmp(exported_json, map_json) == 0);
+    printf("Test: \"saves of the baseline load unchanged\" passed\n");
+
+    free(exported_json);
+    free(exported);
+    free_map(map);
+    free(map_json);
+    free(revealed_json);
+
+    rc = sqlite3_exec(db_connection.db, "DELETE FROM game_state;", NULL, NULL, NULL);
+    assert(rc == SQLITE_OK);
+    rc = sqlite3_exec(db_connection.db, "DELETE FROM map_state;", NULL, NULL, NULL);
+    assert(rc == SQLITE_OK);
+    rc = sqlite3_exec(db_connection.db, "DELETE FROM player_state;", NULL, NULL, NULL);
+    assert(rc == SQLITE_OK);
+    db_close(&db_connection);
+}
+
 // This function can only be used manually because creating tables has no guarantee that it will create synchronously
 // sqlite3_step() is not thread safe, but if tested manually, it works perfectly
 // maybe replace with sqlite3_exec() in the future
@@ -166,6 +258,7 @@ int main() {
     // Run the test
     test_create_gamestate_tables();
     test_save_game_state();
+    test_load_baseline_save();
     clean_up_sqlite_sequences();
     // drop_tables(); // Only manually
     return 0;
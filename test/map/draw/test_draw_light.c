@@ -2,6 +2,8 @@
 
 #include <assert.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 const int width = 10;
 const int height = 10;
@@ -30,7 +32,7 @@ void reset_test_mazes(void) {
 void print_array(const int* array) {
     for (int y = 0; y < height; y++) {
         for (int x = 0; x < width; x++) {
-            printf("%d ", array[x * height + y]);
+            printf("%d ", array[y * width + x]);
         }
         printf("\n");
     }
@@ -220,8 +222,212 @@ void test_draw_light_on_player(void) {
     printf("test_draw_light_on_player all tests passed\n");
 }
 
+/**
+ * Test function to verify that a single pillar casts a shadow and the light stops at the radius
+ */
+void test_draw_light_shadow(void) {
+    const int size = 21;
+    map_tile_t* map = malloc(size * size * sizeof(map_tile_t));
+    map_tile_t* revealed = malloc(size * size * sizeof(map_tile_t));
+    assert(map != NULL && revealed != NULL);
+    for (int i = 0; i < size * size; i++) {
+        map[i] = FLOOR;
+        revealed[i] = HIDDEN;
+    }
+    map[8 * size + 10] = WALL;
+
+    const vector2d_t player = {10, 10};
+    draw_light_on_player(map, revealed, size, size, player, 6);
+
+    assert(revealed[8 * size + 10] == WALL);
+    // straight behind the pillar
+    assert(revealed[7 * size + 10] == HIDDEN);
+    assert(revealed[5 * size + 10] == HIDDEN);
+    // next to the shadow
+    assert(revealed[6 * size + 12] == FLOOR);
+    assert(revealed[8 * size + 9] == FLOOR);
+    // the light reaches 6 steps
+    assert(revealed[10 * size + 16] == FLOOR);
+    assert(revealed[13 * size + 13] == FLOOR);
+    assert(revealed[10 * size + 17] == HIDDEN);
+    assert(revealed[14 * size + 13] == HIDDEN);
+
+    free(map);
+    free(revealed);
+    printf("Test: \"a pillar casts a shadow\" passed\n");
+}
+
+/**
+ * Test function to verify that the player sees a floor tile exactly if it can see the player from there
+ */
+void test_draw_light_symmetry(void) {
+    const int size = 41;
+    const int light_radius = 8;
+    const int cells = size * size;
+    map_tile_t* map = malloc(cells * sizeof(map_tile_t));
+    map_tile_t* revealed = malloc(cells * sizeof(map_tile_t));
+    unsigned char* visible = calloc((size_t) cells * cells, 1);
+    assert(map != NULL && revealed != NULL && visible != NULL);
+
+    srand(42);
+    for (int i = 0; i < cells; i++) {
+        map[i] = rand() % 10 < 3 ? WALL : FLOOR;
+    }
+
+    for (int from = 0; from < cells; from++) {
+        if (map[from] == WALL) continue;
+        for (int i = 0; i < cells; i++) {
+            revealed[i] = HIDDEN;
+        }
+        const vector2d_t player = {from % size, from / size};
+        draw_light_on_player(map, revealed, size, size, player, light_radius);
+        for (int to = 0; to < cells; to++) {
+            visible[(size_t) from * cells + to] = revealed[to] != HIDDEN;
+        }
+    }
+
+    for (int from = 0; from < cells; from++) {
+        for (int to = 0; to < cells; to++) {
+            if (from == to || map[from] == WALL || map[to] == WALL) continue;
+            assert(visible[(size_t) from * cells + to] == visible[(size_t) to * cells + from]);
+        }
+    }
+
+    free(map);
+    free(revealed);
+    free(visible);
+    printf("Test: \"the light is symmetric\" passed\n");
+}
+
+/**
+ * @brief Counts the visits of every tile.
+ * @param data the visit counts, one per tile of a 21 x 21 map
+ * @param x the x coordinate of the tile
+ * @param y the y coordinate of the tile
+ * @param steps unused
+ */
+void count_visits(void* data, const int x, const int y, const int steps) {
+    (void) steps;
+    int* visits = data;
+    visits[y * 21 + x]++;
+}
+
+/**
+ * Test function to verify that the quadrants do not share the diagonals
+ */
+void test_field_of_view_visits_once(void) {
+    const int size = 21;
+    map_tile_t map[21 * 21];
+    int visits[21 * 21];
+    for (int i = 0; i < size * size; i++) {
+        map[i] = FLOOR;
+        visits[i] = 0;
+    }
+    // a wall on a diagonal still casts its shadow
+    map[7 * size + 7] = WALL;
+
+    cast_field_of_view(map, size, size, (vector2d_t) {10, 10}, 8, count_visits, visits);
+    int visited = 0;
+    for (int i = 0; i < size * size; i++) {
+        assert(visits[i] <= 1);
+        visited += visits[i];
+    }
+    assert(visits[10 * size + 10] == 0);
+    assert(visits[14 * size + 14] == 1 && visits[6 * size + 14] == 1 && visits[14 * size + 6] == 1);
+    assert(visits[7 * size + 7] == 1 && visits[6 * size + 6] == 0);
+    // the diamond of radius 8 without the origin and the tile behind the wall
+    assert(visited == 2 * 8 * 9 - 1);
+    printf("Test: \"every tile is visited once\" passed\n");
+}
+
+/**
+ * Test function to verify that the light is only drawn again if the player or the map changed
+ */
+void test_update_light_cache(void) {
+    map_t* map = init_map(21, 21);
+    assert(map != NULL);
+    for (int y = 1; y < 20; y++) {
+        for (int x = 1; x < 20; x++) {
+            MAP_TILE(map, x, y) = FLOOR;
+        }
+    }
+    mark_map_changed(map);
+    light_cache_t cache = LIGHT_CACHE_EMPTY;
+    vector2d_t player = {10, 10};
+
+    assert(update_light(&cache, map, NULL, player, 3, 0) == 1);
+    assert(MAP_REVEALED(map, 10, 7) == FLOOR);
+    // idle frames do not draw
+    assert(update_light(&cache, map, NULL, player, 3, 0) == 0);
+    assert(update_light(&cache, map, NULL, player, 3, 0) == 0);
+
+    player.dx++;
+    assert(update_light(&cache, map, NULL, player, 3, 0) == 1);
+    assert(MAP_REVEALED(map, 14, 10) == FLOOR);
+    assert(update_light(&cache, map, NULL, player, 4, 0) == 1);
+
+    // a changed tile is drawn with the next update
+    MAP_TILE(map, 11, 8) = GOBLIN;
+    assert(update_light(&cache, map, NULL, player, 4, 0) == 0);
+    mark_map_changed(map);
+    assert(update_light(&cache, map, NULL, player, 4, 0) == 1);
+    assert(MAP_REVEALED(map, 11, 8) == GOBLIN);
+
+    // another map never shares the version
+    map_t* other = init_map(21, 21);
+    assert(other != NULL && other->version != map->version);
+    assert(update_light(&cache, other, NULL, player, 4, 0) == 1);
+
+    free_map(other);
+    free_map(map);
+    printf("Test: \"the light is only drawn after a change\" passed\n");
+}
+
+/**
+ * Test function to verify that lit tiles stay seen after the light moved away
+ */
+void test_update_light_bits(void) {
+    map_t* map = init_map(101, 21);
+    assert(map != NULL);
+    for (int x = 1; x < 100; x++) {
+        MAP_TILE(map, x, 10) = FLOOR;
+    }
+    mark_map_changed(map);
+    light_cache_t cache = LIGHT_CACHE_EMPTY;
+
+    // the light crosses the word boundary at x = 64
+    assert(update_light(&cache, map, NULL, (vector2d_t) {62, 10}, 4, 0) == 1);
+    assert(MAP_SEEN(map, 66, 10) && MAP_SEEN(map, 58, 10) && MAP_SEEN(map, 62, 9));
+    assert(!MAP_SEEN(map, 67, 10) && MAP_REVEALED(map, 67, 10) == HIDDEN);
+    assert(MAP_REVEALED(map, 66, 10) == FLOOR && MAP_REVEALED(map, 62, 9) == WALL);
+
+    assert(update_light(&cache, map, NULL, (vector2d_t) {20, 10}, 4, 0) == 1);
+    // the old light is no longer visible, but still seen
+    assert(MAP_SEEN(map, 66, 10));
+    assert(!((map->visible[10 * map->row_words + 1] >> (66 - 64)) & 1ULL));
+    assert((map->visible[10 * map->row_words] >> 24) & 1ULL);
+
+    // a save stores one tile per cell, column by column
+    map_tile_t* revealed = export_revealed_tiles(map);
+    assert(revealed != NULL);
+    assert(revealed[66 * map->height + 10] == FLOOR && revealed[40 * map->height + 10] == HIDDEN);
+    clear_revealed(map);
+    assert(!MAP_SEEN(map, 66, 10));
+    import_revealed_tiles(map, revealed);
+    assert(MAP_SEEN(map, 66, 10) && MAP_SEEN(map, 24, 10) && !MAP_SEEN(map, 40, 10));
+
+    free(revealed);
+    free_map(map);
+    printf("Test: \"lit tiles stay seen\" passed\n");
+}
+
 
 int main(void) {
     test_draw_light_on_player();
+    test_draw_light_shadow();
+    test_draw_light_symmetry();
+    test_field_of_view_visits_once();
+    test_update_light_cache();
+    test_update_light_bits();
     return 0;
 }
@@ -0,0 +1,172 @@
+#include "../src/map/draw/draw_light.h"
+#include "../src/map/draw/light_map.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Creates an open map with a border of walls
+ */
+map_t* create_open_map(const int width, const int height) {
+    map_t* map = init_map(width, height);
+    assert(map != NULL);
+    for (int y = 1; y < height - 1; y++) {
+        for (int x = 1; x < width - 1; x++) {
+            MAP_TILE(map, x, y) = FLOOR;
+        }
+    }
+    mark_map_changed(map);
+    return map;
+}
+
+/**
+ * Checks that both light maps contain the same light
+ */
+void assert_same_light(const light_map_t* first, const light_map_t* second) {
+    assert(first->width == second->width && first->height == second->height);
+    const size_t size = (size_t) first->width * first->height * sizeof(uint32_t);
+    assert(memcmp(first->intensity, second->intensity, size) == 0);
+}
+
+/**
+ * Test function to verify the light of a single source
+ */
+void test_light_source(void) {
+    map_t* map = create_open_map(21, 21);
+    // a wall right of the source
+    MAP_TILE(map, 12, 10) = WALL;
+    mark_map_changed(map);
+    light_map_t* lights = init_light_map(21, 21);
+    assert(lights != NULL);
+
+    const int id = add_light_source(lights, map, (vector2d_t) {10, 10}, 4, 200);
+    assert(id == 0);
+    assert(LIGHT_AT(lights, 10, 10) == 200);
+    // the light falls off with the steps and ends after the radius
+    assert(LIGHT_AT(lights, 10, 9) == 160);
+    assert(LIGHT_AT(lights, 10, 6) == 40);
+    assert(LIGHT_AT(lights, 10, 5) == 0);
+    assert(LIGHT_AT(lights, 12, 12) == 40);
+    // the wall is lit, the tile behind it is not
+    assert(LIGHT_AT(lights, 12, 10) == 120);
+    assert(LIGHT_AT(lights, 13, 10) == 0);
+
+    // overlapping sources add up, the sum is clamped
+    const int second = add_light_source(lights, map, (vector2d_t) {10, 10}, 2, 100);
+    assert(second == 1);
+    assert(LIGHT_AT(lights, 10, 10) == MAX_LIGHT_INTENSITY);
+    assert(LIGHT_AT(lights, 10, 9) == 160 + 66);
+
+    remove_light_source(lights, id);
+    assert(LIGHT_AT(lights, 10, 10) == 100 && LIGHT_AT(lights, 10, 6) == 0);
+    assert(move_light_source(lights, map, second, (vector2d_t) {5, 5}) == 0);
+    assert(LIGHT_AT(lights, 10, 10) == 0 && LIGHT_AT(lights, 5, 5) == 100);
+    // a removed source is not moved
+    assert(move_light_source(lights, map, id, (vector2d_t) {5, 5}) != 0);
+    assert(add_light_source(lights, map, (vector2d_t) {21, 5}, 2, 100) == NO_LIGHT_SOURCE);
+
+    free_light_map(lights);
+    free_map(map);
+    printf("Test: \"light of a single source\" passed\n");
+}
+
+/**
+ * Test function to verify that a changed tile only casts the light of the sources reaching it again
+ */
+void test_light_area_update(void) {
+    const int size = 201;
+    map_t* map = create_open_map(size, size);
+    srand(14);
+    for (int i = 0; i < size * size / 6; i++) {
+        MAP_TILE(map, 1 + rand() % (size - 2), 1 + rand() % (size - 2)) = WALL;
+    }
+    mark_map_changed(map);
+
+    light_map_t* lights = init_light_map(size, size);
+    assert(lights != NULL);
+    const int source_count = 400;
+    vector2d_t positions[400];
+    for (int i = 0; i < source_count; i++) {
+        positions[i] = (vector2d_t) {1 + rand() % (size - 2), 1 + rand() % (size - 2)};
+        assert(add_light_source(lights, map, positions[i], 6, 120) == i);
+    }
+
+    // open a wall in the middle of the floor
+    int wall_x = size / 2;
+    while (MAP_TILE(map, wall_x, size / 2) != WALL) wall_x++;
+    MAP_TILE(map, wall_x, size / 2) = FLOOR;
+    mark_map_changed(map);
+    const uint64_t version = lights->version;
+    const int updated = update_light_area(lights, map, wall_x, size / 2, wall_x, size / 2);
+
+    int expected_updated = 0;
+    for (int i = 0; i < source_count; i++) {
+        if (abs(positions[i].dx - wall_x) <= 6 && abs(positions[i].dy - size / 2) <= 6) expected_updated++;
+    }
+    assert(updated == expected_updated && updated < source_count);
+    assert(updated == 0 || lights->version != version);
+
+    // the result is the same as placing all lights on the changed floor
+    light_map_t* fresh = init_light_map(size, size);
+    assert(fresh != NULL);
+    for (int i = 0; i < source_count; i++) {
+        assert(add_light_source(fresh, map, positions[i], 6, 120) == i);
+    }
+    assert_same_light(lights, fresh);
+
+    // no light is left after every source was removed
+    for (int i = 0; i < source_count; i++) {
+        remove_light_source(lights, i);
+    }
+    light_map_t* empty = init_light_map(size, size);
+    assert(empty != NULL);
+    assert_same_light(lights, empty);
+
+    free_light_map(empty);
+    free_light_map(fresh);
+    free_light_map(lights);
+    free_map(map);
+    printf("Test: \"a changed tile only updates the lights reaching it\" passed\n");
+}
+
+/**
+ * Test function to verify that the player sees lit tiles within the sight radius
+ */
+void test_update_light_with_lights(void) {
+    map_t* map = create_open_map(41, 21);
+    // a wall splits the floor, with a gap at the top
+    for (int y = 3; y < 20; y++) {
+        MAP_TILE(map, 20, y) = WALL;
+    }
+    mark_map_changed(map);
+    light_map_t* lights = init_light_map(41, 21);
+    assert(lights != NULL);
+    assert(add_light_source(lights, map, (vector2d_t) {10, 10}, 3, 100) == 0);
+    assert(add_light_source(lights, map, (vector2d_t) {30, 10}, 3, 100) == 1);
+
+    light_cache_t cache = LIGHT_CACHE_EMPTY;
+    assert(update_light(&cache, map, lights, (vector2d_t) {10, 18}, 2, 12) == 1);
+    // the light in sight is visible, the light behind the wall and dark tiles are not
+    assert(MAP_SEEN(map, 10, 10) && MAP_SEEN(map, 10, 8));
+    assert(!MAP_SEEN(map, 30, 10));
+    assert(!MAP_SEEN(map, 4, 15));
+    assert(update_light(&cache, map, lights, (vector2d_t) {10, 18}, 2, 12) == 0);
+
+    // a changed light is drawn with the next update
+    assert(move_light_source(lights, map, 0, (vector2d_t) {4, 14}) == 0);
+    assert(update_light(&cache, map, lights, (vector2d_t) {10, 18}, 2, 12) == 1);
+    assert(MAP_SEEN(map, 4, 15));
+
+    free_light_map(lights);
+    free_map(map);
+    printf("Test: \"lit tiles in sight are seen\" passed\n");
+}
+
+int main(void) {
+    test_light_source();
+    test_light_area_update();
+    test_update_light_with_lights();
+    return 0;
+}
@@ -0,0 +1,105 @@
+#include "../src/map/floor_pipeline.h"
+#include "../src/map/map.h"
+#include "../src/map/map_generator.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * Checks that both maps contain the same floor
+ */
+void assert_same_floor(const map_t* first, const map_t* second) {
+    assert(first->width == second->width && first->height == second->height);
+    const size_t size = (size_t) first->width * first->height * sizeof(map_tile_t);
+    assert(memcmp(first->tiles, second->tiles, size) == 0);
+    assert(first->exit_edge == second->exit_edge);
+}
+
+/**
+ * Test function to verify that a prepared floor is the same floor the generator would create
+ */
+void test_floor_pipeline_prepared() {
+    map_t* first = take_floor(NULL, 1, 7);
+    assert(first != NULL);
+
+    prepare_next_floor(first, 2, 8);
+    map_t* second = take_floor(first, 2, 8);
+    assert(second != NULL);
+
+    map_t* expected = init_map(second->width, second->height);
+    assert(expected != NULL);
+    assert(generate_map(expected, first, 8, get_floor_layout(2)) == 0);
+    assert_same_floor(second, expected);
+
+    free_map(expected);
+    release_floor(first);
+    release_floor(second);
+    printf("Test passed: The prepared floor matches the generated floor.\n");
+}
+
+/**
+ * Test function to verify that the floor is prepared in the spare map and that very map is handed back
+ */
+void test_floor_pipeline_spare() {
+    map_t* first = take_floor(NULL, 1, 21);
+    assert(first != NULL);
+    // the map handed back becomes the spare map
+    release_floor(first);
+
+    // the next floor of the same size is generated into the spare map
+    prepare_next_floor(NULL, 1, 22);
+    map_t* second = take_floor(NULL, 1, 22);
+    assert(second == first);
+
+    map_t* expected = init_map(second->width, second->height);
+    assert(expected != NULL);
+    assert(generate_map(expected, NULL, 22, get_floor_layout(1)) == 0);
+    assert_same_floor(second, expected);
+
+    free_map(expected);
+    release_floor(second);
+    printf("Test passed: The floor is prepared in the spare map and handed back.\n");
+}
+
+/**
+ * Test function to verify that a prepared floor is not used for a different request
+ */
+void test_floor_pipeline_mismatch() {
+    map_t* first = take_floor(NULL, 1, 11);
+    assert(first != NULL);
+
+    prepare_next_floor(first, 2, 12);
+    // e.g. a save was loaded in the meantime
+    map_t* other = take_floor(first, 2, 13);
+    assert(other != NULL);
+
+    map_t* expected = init_map(other->width, other->height);
+    assert(expected != NULL);
+    assert(generate_map(expected, first, 13, get_floor_layout(2)) == 0);
+    assert_same_floor(other, expected);
+
+    // the memory of a prepared floor for another request is reused
+    release_floor(other);
+    prepare_next_floor(first, 2, 14);
+    map_t* reused = take_floor(first, 2, 15);
+    assert(reused == other);
+    assert(generate_map(expected, first, 15, get_floor_layout(2)) == 0);
+    assert_same_floor(reused, expected);
+
+    free_map(expected);
+    release_floor(first);
+    release_floor(reused);
+    printf("Test passed: A prepared floor for another request is not used.\n");
+}
+
+int main(void) {
+    assert(init_floor_pipeline() == 0);
+    test_floor_pipeline_prepared();
+    test_floor_pipeline_spare();
+    test_floor_pipeline_mismatch();
+    // a pending floor is finished before the pipeline stops
+    prepare_next_floor(NULL, 20, 1);
+    shutdown_floor_pipeline();
+    return 0;
+}
@@ -1,10 +1,15 @@
+#include "../src/map/layout/cave_layout.h"
 #include "../src/map/map.h"
 #include "../src/map/map_generator.h"
+#include "../src/map/map_populator.h"
+#include "../src/map/map_regions.h"
 
 #include <assert.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
-int visited_test[WIDTH][HEIGHT];
+int* visited_test;
 
 /**
  * Perform DFS to check if there is a path from start to exit
@@ -14,20 +19,20 @@ int visited_test[WIDTH][HEIGHT];
  */
 int dfs_check_path(int x, int y) {
     // If out of bounds or already visited, return 0
-    if (x < 0 || x >= WIDTH || y < 0 || y >= HEIGHT || visited_test[x][y]) {
+    if (x < 0 || x >= current_map->width || y < 0 || y >= current_map->height || visited_test[y * current_map->width + x]) {
         return 0;
     }
 
     // Mark the current cell as visited
-    visited_test[x][y] = 1;
+    visited_test[y * current_map->width + x] = 1;
 
     // If we reach the EXIT_DOOR, return 1
-    if (map[x][y] == EXIT_DOOR) {
+    if (MAP_TILE(current_map, x, y) == EXIT_DOOR) {
         return 1;
     }
 
     // If the current cell is a wall, return 0
-    if (map[x][y] == WALL) {
+    if (MAP_TILE(current_map, x, y) == WALL) {
         return 0;
     }
 
@@ -47,15 +52,26 @@ int dfs_check_path(int x, int y) {
 /**
  * Test function to verify if there is a path from START_DOOR to EXIT_DOOR
  */
-void test_map_generator_path() {
+void test_map_generator_path(const int floor) {
     // Generate the map
-    generate_map();
+    int width;
+    int height;
+    get_floor_dimensions(floor, &width, &height);
+    map_t* next_floor = init_map(width, height);
+    assert(next_floor != NULL);
+    assert(next_floor->width == width && next_floor->height == height);
+    assert(generate_map(next_floor, current_map, derive_seed(42, floor), get_floor_layout(floor)) == 0);
+    if (current_map != NULL && current_map->exit_edge != NO_EDGE) {
+        // the new floor starts at the exit of the previous floor
+        assert(next_floor->start_edge != current_map->exit_edge);
+    }
+    replace_current_map(next_floor);
 
     // Find the start position
     int start_x = -1, start_y = -1;
-    for (int y = 0; y < HEIGHT; y++) {
-        for (int x = 0; x < WIDTH; x++) {
-            if (map[x][y] == START_DOOR) {
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            if (MAP_TILE(current_map, x, y) == START_DOOR) {
                 start_x = x;
                 start_y = y;
                 break;
@@ -66,24 +82,395 @@ void test_map_generator_path() {
 
     // Ensure the start position was found
     assert(start_x != -1 && start_y != -1);
+    assert(abs(current_map->start.dx - start_x) + abs(current_map->start.dy - start_y) == 1);
 
     // Reset the visited array
-    for (int y = 0; y < HEIGHT; y++) {
-        for (int x = 0; x < WIDTH; x++) {
-            visited_test[x][y] = 0;
-        }
-    }
+    visited_test = calloc(width * height, sizeof(int));
+    assert(visited_test != NULL);
 
     // Perform DFS to check if a path exists
     int path_exists = dfs_check_path(start_x, start_y);
+    free(visited_test);
 
     // Assert that a path exists
     assert(path_exists == 1);
 
-    printf("Test passed: Path from START_DOOR to EXIT_DOOR exists.\n");
+    printf("Test passed: Path from START_DOOR to EXIT_DOOR exists on a %d x %d floor.\n", width, height);
+}
+
+/**
+ * Test function to verify that large floors are carved completely without running out of stack
+ */
+void test_map_generator_large_floor() {
+    const int width = 2001;
+    const int height = 2001;
+    assert(resize_current_map(width, height) == 0);
+    assert(generate_map(current_map, NULL, generate_seed(), LAYOUT_MAZE) == 0);
+
+    // every maze cell (odd coordinates) must be reachable, so none of them is a wall
+    for (int y = 1; y < height; y += 2) {
+        for (int x = 1; x < width; x += 2) {
+            assert(MAP_TILE(current_map, x, y) != WALL);
+        }
+    }
+
+    printf("Test passed: All cells of a %d x %d floor were carved.\n", width, height);
+}
+
+/**
+ * Test function to verify that every layout connects all of its cells to the start
+ */
+void test_map_generator_layouts() {
+    const int sizes[][2] = {{39, 19}, {81, 41}, {201, 101}};
+    for (int layout = 0; layout < MAX_LAYOUTS; layout++) {
+        for (int s = 0; s < 3; s++) {
+            const int width = sizes[s][0];
+            const int height = sizes[s][1];
+            map_t* map = init_map(width, height);
+            assert(map != NULL);
+            assert(generate_map(map, NULL, derive_seed(7, (uint64_t) s), (floor_layout_t) layout) == 0);
+            assert(MAP_TILE(map, map->start.dx, map->start.dy) == FLOOR);
+
+            // flood fill from the start, the doors are reached but not passed
+            int* visited = calloc((size_t) width * height, sizeof(int));
+            int* queue = malloc((size_t) width * height * sizeof(int));
+            assert(visited != NULL && queue != NULL);
+            int head = 0;
+            int tail = 0;
+            queue[tail++] = map->start.dy * width + map->start.dx;
+            visited[queue[0]] = 1;
+            while (head < tail) {
+                const int cell = queue[head++];
+                if (map->tiles[cell] == START_DOOR || map->tiles[cell] == EXIT_DOOR) continue;
+                for (int i = 0; i < 4; i++) {
+                    const int x = cell % width + directions[i].dx;
+                    const int y = cell / width + directions[i].dy;
+                    if (x < 0 || x >= width || y < 0 || y >= height) continue;
+                    const int next = y * width + x;
+                    if (visited[next] || map->tiles[next] == WALL) continue;
+                    visited[next] = 1;
+                    queue[tail++] = next;
+                }
+            }
+
+            // no cell is cut off, so the exit, the key and all enemies can be reached
+            for (int i = 0; i < width * height; i++) {
+                assert(map->tiles[i] == WALL || visited[i]);
+            }
+            assert(map->exit_edge != NO_EDGE && visited[map->exit.dy * width + map->exit.dx]);
+
+            free(visited);
+            free(queue);
+            free_map(map);
+        }
+        printf("Test passed: The %s layout connects every cell to the start.\n", layout_generators[layout].name);
+    }
+}
+
+/**
+ * Test function to verify that the bit packed cave smoothing matches a plain neighbour count
+ */
+void test_cave_smoothing() {
+    // widths around the word size catch mistakes at the word boundaries
+    const int widths[] = {10, 63, 64, 65, 130};
+    const int height = 12;
+    rng_t rng;
+    init_rng(&rng, 5);
+    for (int w = 0; w < 5; w++) {
+        const int width = widths[w];
+        const int words = cave_row_words(width);
+        uint64_t* current = calloc((size_t) words * height, sizeof(uint64_t));
+        uint64_t* next = calloc((size_t) words * height, sizeof(uint64_t));
+        assert(current != NULL && next != NULL);
+
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                const int border = x == 0 || y == 0 || x == width - 1 || y == height - 1;
+                if (border || rng_range(&rng, 2)) current[y * words + x / 64] |= 1ULL << (x % 64);
+            }
+        }
+        smooth_cave(current, next, width, height);
+
+        for (int y = 1; y < height - 1; y++) {
+            for (int x = 1; x < width - 1; x++) {
+                int walls = 0;
+                for (int dy = -1; dy <= 1; dy++) {
+                    for (int dx = -1; dx <= 1; dx++) {
+                        walls += (int) ((current[(y + dy) * words + (x + dx) / 64] >> ((x + dx) % 64)) & 1ULL);
+                    }
+                }
+                const int expected = walls >= CAVE_WALL_THRESHOLD;
+                assert((int) ((next[y * words + x / 64] >> (x % 64)) & 1ULL) == expected);
+            }
+        }
+        // the border stays a wall
+        for (int x = 0; x < width; x++) {
+            assert((next[x / 64] >> (x % 64)) & 1ULL);
+        }
+        free(current);
+        free(next);
+    }
+    printf("Test passed: The bit packed cave smoothing matches the neighbour count.\n");
+}
+
+/**
+ * Test function to verify that the same seed always generates the same floor
+ */
+void test_map_generator_seed() {
+    map_t* first = init_map(DEFAULT_MAP_WIDTH, DEFAULT_MAP_HEIGHT);
+    map_t* second = init_map(DEFAULT_MAP_WIDTH, DEFAULT_MAP_HEIGHT);
+    assert(first != NULL && second != NULL);
+    const size_t size = (size_t) DEFAULT_MAP_WIDTH * DEFAULT_MAP_HEIGHT * sizeof(map_tile_t);
+
+    assert(generate_map(first, NULL, 1234, LAYOUT_MAZE) == 0);
+    assert(generate_map(second, NULL, 1234, LAYOUT_MAZE) == 0);
+    assert(memcmp(first->tiles, second->tiles, size) == 0);
+
+    // the previous floor may be the map itself, its exit is read before the map is regenerated
+    const vector2d_t exit = first->exit;
+    assert(generate_map(first, first, 99, LAYOUT_MAZE) == 0);
+    assert(generate_map(second, second, 99, LAYOUT_MAZE) == 0);
+    assert(memcmp(first->tiles, second->tiles, size) == 0);
+    assert(first->start.dx == exit.dx || first->start.dy == exit.dy);
+
+    assert(generate_map(second, NULL, 4321, LAYOUT_MAZE) == 0);
+    assert(memcmp(first->tiles, second->tiles, size) != 0);
+
+    free_map(first);
+    free_map(second);
+    printf("Test passed: The same seed generates the same floor.\n");
+}
+
+/**
+ * Test function to verify the population of a floor and that impossible placements are reported
+ */
+void test_map_populator() {
+    map_t* map = init_map(DEFAULT_MAP_WIDTH, DEFAULT_MAP_HEIGHT);
+    assert(map != NULL);
+    rng_t rng;
+    init_rng(&rng, 5);
+
+    // a map without any floor has no place for the key, this must not loop forever
+    assert(populate_map(map, &rng, NULL, ENEMY_COUNT) == POPULATE_NO_KEY_POSITION);
+
+    assert(generate_map(map, NULL, 5, LAYOUT_MAZE) == 0);
+    int keys = 0, enemies = 0, life_fountains = 0, mana_fountains = 0;
+    for (int i = 0; i < map->width * map->height; i++) {
+        keys += map->tiles[i] == KEY;
+        enemies += map->tiles[i] == GOBLIN;
+        life_fountains += map->tiles[i] == LIFE_FOUNTAIN;
+        mana_fountains += map->tiles[i] == MANA_FOUNTAIN;
+    }
+    assert(keys == 1 && enemies == ENEMY_COUNT && life_fountains == 1 && mana_fountains == 1);
+
+    free_map(map);
+    printf("Test passed: The floor is populated and impossible placements are reported.\n");
+}
+
+/**
+ * Test function to verify the region labels and sizes of a floor with separated areas
+ */
+void test_map_regions() {
+    map_t* map = init_map(15, 9);
+    assert(map != NULL);
+    for (int i = 0; i < map->width * map->height; i++) {
+        map->tiles[i] = WALL;
+    }
+    // a corridor from the start door, a 3 x 3 room and a single cell
+    map->start_edge = LEFT;
+    map->start = (vector2d_t) {1, 1};
+    MAP_TILE(map, 0, 1) = START_DOOR;
+    for (int x = 1; x < 14; x++) {
+        MAP_TILE(map, x, 1) = FLOOR;
+    }
+    for (int y = 3; y < 6; y++) {
+        for (int x = 2; x < 5; x++) {
+            MAP_TILE(map, x, y) = FLOOR;
+        }
+    }
+    MAP_TILE(map, 4, 6) = KEY;// items do not split a region
+    MAP_TILE(map, 10, 5) = FLOOR;
+
+    region_index_t* regions = init_region_index(map->width, map->height);
+    assert(regions != NULL);
+    assert(build_region_index(regions, map) == 0);
+
+    assert(regions->region_count == 3);
+    const int corridor = REGION_AT(regions, 13, 1);
+    const int room = REGION_AT(regions, 2, 3);
+    const int cell = REGION_AT(regions, 10, 5);
+    assert(corridor != room && room != cell && cell != corridor);
+    assert(REGION_AT(regions, 0, 1) == corridor && regions->sizes[corridor] == 14);
+    assert(REGION_AT(regions, 4, 6) == room && regions->sizes[room] == 10);
+    assert(regions->sizes[cell] == 1);
+    assert(REGION_AT(regions, 0, 0) == NO_REGION);
+
+    assert(get_start_region(regions, map) == corridor);
+    assert(is_in_start_region(regions, map, 7, 1));
+    assert(!is_in_start_region(regions, map, 3, 4));
+    assert(!is_in_start_region(regions, map, 7, 2));
+
+    // a different size is rejected
+    map_t* other = init_map(17, 9);
+    assert(other != NULL);
+    assert(build_region_index(regions, other) != 0);
+
+    free_map(other);
+    free_region_index(regions);
+    free_map(map);
+    printf("Test passed: The regions of a floor are labelled with their sizes.\n");
+}
+
+/**
+ * Test function to verify that only cells reachable from the start are populated
+ */
+void test_map_populator_start_region() {
+    map_t* map = init_map(DEFAULT_MAP_WIDTH, DEFAULT_MAP_HEIGHT);
+    assert(map != NULL);
+    for (int i = 0; i < map->width * map->height; i++) {
+        map->tiles[i] = WALL;
+    }
+    // a long corridor from the start and a large cut off area below it
+    map->start_edge = LEFT;
+    map->start = (vector2d_t) {1, 1};
+    MAP_TILE(map, 0, 1) = START_DOOR;
+    for (int x = 1; x < map->width - 1; x++) {
+        MAP_TILE(map, x, 1) = FLOOR;
+    }
+    for (int y = 3; y < map->height - 1; y++) {
+        for (int x = 1; x < map->width - 1; x++) {
+            MAP_TILE(map, x, y) = FLOOR;
+        }
+    }
+
+    region_index_t* regions = init_region_index(map->width, map->height);
+    assert(regions != NULL);
+    assert(build_region_index(regions, map) == 0);
+    rng_t rng;
+    init_rng(&rng, 3);
+    assert(populate_map(map, &rng, regions, 2) == POPULATE_SUCCESS);
+
+    int placed = 0;
+    for (int y = 0; y < map->height; y++) {
+        for (int x = 0; x < map->width; x++) {
+            const map_tile_t tile = MAP_TILE(map, x, y);
+            if (tile == KEY || tile == GOBLIN || tile == LIFE_FOUNTAIN || tile == MANA_FOUNTAIN) {
+                assert(y == 1);
+                placed++;
+            }
+        }
+    }
+    assert(placed == 5);
+
+    free_region_index(regions);
+    free_map(map);
+    printf("Test passed: Only cells reachable from the start are populated.\n");
+}
+
+/**
+ * Test function to verify that cells too close to an enemy are still used for the fountains
+ */
+void test_map_populator_excluded_cells() {
+    map_t* map = init_map(MIN_MAP_WIDTH, MIN_MAP_HEIGHT);
+    assert(map != NULL);
+    int placed = 0;
+    for (uint64_t seed = 0; seed < 500; seed++) {
+        // a room of two rows without dead ends, two enemies only fit near both ends
+        for (int y = 0; y < map->height; y++) {
+            for (int x = 0; x < map->width; x++) {
+                MAP_TILE(map, x, y) = (y == 1 || y == 2) && x > 0 && x < map->width - 1 ? FLOOR : WALL;
+            }
+        }
+        rng_t rng;
+        init_rng(&rng, seed);
+        const populate_result_t result = populate_map(map, &rng, NULL, 2);
+        // not every room has space for all enemies, the fountains are placed anyway
+        assert(result == POPULATE_SUCCESS || result == POPULATE_FEWER_ENEMIES);
+        placed += result == POPULATE_SUCCESS;
+    }
+    assert(placed > 0);
+
+    free_map(map);
+    printf("Test passed: Cells too close to an enemy are still used for items.\n");
+}
+
+/**
+ * Test function to verify that the smallest floors are generated with fewer enemies
+ */
+void test_map_generator_min_size() {
+    map_t* map = init_map(MIN_MAP_WIDTH, MIN_MAP_HEIGHT);
+    assert(map != NULL);
+    for (int layout = 0; layout < MAX_LAYOUTS; layout++) {
+        for (uint64_t seed = 0; seed < 50; seed++) {
+            assert(generate_map(map, NULL, seed, (floor_layout_t) layout) == 0);
+            int keys = 0, enemies = 0, fountains = 0;
+            for (int i = 0; i < map->width * map->height; i++) {
+                keys += map->tiles[i] == KEY;
+                enemies += map->tiles[i] == GOBLIN;
+                fountains += map->tiles[i] == LIFE_FOUNTAIN || map->tiles[i] == MANA_FOUNTAIN;
+            }
+            assert(keys == 1 && fountains == 2 && enemies < ENEMY_COUNT);
+        }
+    }
+
+    free_map(map);
+    printf("Test passed: The smallest floors are generated with fewer enemies.\n");
+}
+
+/**
+ * Test function to verify that thousands of enemies keep their distance to each other
+ */
+void test_map_populator_many_enemies() {
+    const int enemy_count = 2000;
+    map_t* map = init_map(1001, 1001);
+    assert(map != NULL);
+    assert(generate_map(map, NULL, 77, LAYOUT_MAZE) == 0);
+    // the generated floor already has ENEMY_COUNT enemies, remove them and place many more
+    for (int i = 0; i < map->width * map->height; i++) {
+        if (map->tiles[i] == GOBLIN || map->tiles[i] == KEY || map->tiles[i] == LIFE_FOUNTAIN || map->tiles[i] == MANA_FOUNTAIN) {
+            map->tiles[i] = FLOOR;
+        }
+    }
+    rng_t rng;
+    init_rng(&rng, 77);
+    assert(populate_map(map, &rng, NULL, enemy_count) == POPULATE_SUCCESS);
+
+    int enemies = 0;
+    for (int y = 0; y < map->height; y++) {
+        for (int x = 0; x < map->width; x++) {
+            if (MAP_TILE(map, x, y) != GOBLIN) continue;
+            enemies++;
+            // no other enemy within ENEMY_MIN_DISTANCE in any direction
+            for (int ny = y - ENEMY_MIN_DISTANCE; ny <= y + ENEMY_MIN_DISTANCE; ny++) {
+                for (int nx = x - ENEMY_MIN_DISTANCE; nx <= x + ENEMY_MIN_DISTANCE; nx++) {
+                    if ((nx == x && ny == y) || nx < 0 || ny < 0 || nx >= map->width || ny >= map->height) continue;
+                    assert(MAP_TILE(map, nx, ny) != GOBLIN);
+                }
+            }
+        }
+    }
+    assert(enemies == enemy_count);
+
+    free_map(map);
+    printf("Test passed: %d enemies keep their distance.\n", enemy_count);
 }
 
 int main(void) {
-    test_map_generator_path();
+    test_map_generator_path(1);
+    // the next floors are larger and start at the exit of the previous floor
+    test_map_generator_path(2);
+    test_map_generator_path(3);
+    test_map_generator_path(10);
+    test_map_generator_seed();
+    test_map_generator_layouts();
+    test_cave_smoothing();
+    test_map_regions();
+    test_map_populator();
+    test_map_populator_start_region();
+    test_map_populator_excluded_cells();
+    test_map_generator_min_size();
+    test_map_populator_many_enemies();
+    test_map_generator_large_floor();
+    free_map(current_map);
     return 0;
 }
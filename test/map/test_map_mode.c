@@ -1,4 +1,5 @@
 #include "../src/character/character.h"
+#include "../src/io/output/specific/map_output.h"
 #include "../src/map/map.h"
 #include "../src/map/map_mode.h"
 #include "../src/memory/memory_management.h"
@@ -48,11 +49,11 @@ void test_map_mode() {
                     .id = NCKEY_LEFT}};
 
     // Initialize the map and player position
-    init_map_mode();
+    assert(init_map_mode() == COMMON_SUCCESS);
     set_player_start_pos(1, 1);
 
     // Simulate player movement to an empty floor tile
-    map[2][1] = FLOOR;
+    MAP_TILE(current_map, 2, 1) = FLOOR;
 
     map_mode_result_t result = handle_input(&right, c);
     vector2d_t player_pos = get_player_pos();
@@ -60,42 +61,42 @@ void test_map_mode() {
     assert(player_pos.dx == 2 && player_pos.dy == 1);
 
     // Simulate player encountering a goblin
-    map[2][2] = GOBLIN;
+    MAP_TILE(current_map, 2, 2) = GOBLIN;
     result = handle_input(&down, c);
     player_pos = get_player_pos();
     assert(result == COMBAT);
     assert(player_pos.dx == 2 && player_pos.dy == 2);
 
     // Simulate player hitting a wall
-    map[1][2] = WALL;
+    MAP_TILE(current_map, 1, 2) = WALL;
     result = handle_input(&left, c);
     player_pos = get_player_pos();
     assert(result == CONTINUE);
     assert(player_pos.dx == 2 && player_pos.dy == 2);// Position should not change
 
     // Simulate player hitting start door
-    map[3][2] = START_DOOR;
+    MAP_TILE(current_map, 3, 2) = START_DOOR;
     result = handle_input(&right, c);
     player_pos = get_player_pos();
     assert(result == CONTINUE);
     assert(player_pos.dx == 2 && player_pos.dy == 2);// Position should not change
 
     // Simulate player hitting exit door
-    map[2][3] = EXIT_DOOR;
+    MAP_TILE(current_map, 2, 3) = EXIT_DOOR;
     result = handle_input(&down, c);
     player_pos = get_player_pos();
     assert(result == CONTINUE);
     assert(player_pos.dx == 2 && player_pos.dy == 2);// Position should not change
 
     //Simulate player picking up a key
-    map[2][1] = KEY;
+    MAP_TILE(current_map, 2, 1) = KEY;
     result = handle_input(&up, c);
     player_pos = get_player_pos();
     assert(result == CONTINUE);
     assert(player_pos.dx == 2 && player_pos.dy == 1);
 
     // Simulate player using the key on the exit door
-    map[2][0] = EXIT_DOOR;
+    MAP_TILE(current_map, 2, 0) = EXIT_DOOR;
     result = handle_input(&up, c);
     player_pos = get_player_pos();
     assert(result == NEXT_FLOOR);
@@ -104,11 +105,44 @@ void test_map_mode() {
     printf("All map_mode tests passed.\n");
 }
 
+/**
+ * Test function to verify that the window of a large floor follows the player
+ */
+void test_follow_player() {
+    // a floor that fits is drawn completely
+    map_window_t window = {{0, 0}, 0, 0};
+    window = follow_player(window, 39, 19, 120, 40, (vector2d_t) {30, 10});
+    assert(window.origin.dx == 0 && window.origin.dy == 0 && window.width == 39 && window.height == 19);
+
+    // a large floor is cut to the screen and centered on the player
+    window = follow_player(window, 1001, 501, 80, 24, (vector2d_t) {500, 250});
+    assert(window.width == 80 && window.height == 24);
+    assert(window.origin.dx == 460 && window.origin.dy == 238);
+
+    // small steps inside the middle of the window do not move it
+    const map_window_t moved = follow_player(window, 1001, 501, 80, 24, (vector2d_t) {519, 255});
+    assert(moved.origin.dx == 460 && moved.origin.dy == 238);
+
+    // the window is centered again near its edge
+    window = follow_player(window, 1001, 501, 80, 24, (vector2d_t) {530, 250});
+    assert(window.origin.dx == 490 && window.origin.dy == 238);
+
+    // the window never reaches beyond the floor
+    window = follow_player(window, 1001, 501, 80, 24, (vector2d_t) {1000, 0});
+    assert(window.origin.dx == 1001 - 80 && window.origin.dy == 0);
+    window = follow_player(window, 1001, 501, 80, 24, (vector2d_t) {0, 500});
+    assert(window.origin.dx == 0 && window.origin.dy == 501 - 24);
+
+    printf("Test passed: The window follows the player.\n");
+}
+
 int main() {
     setup();
 
     test_map_mode();
+    test_follow_player();
 
+    shutdown_map_mode();
     shutdown_memory_pool(test_map_mode_memory_pool);
     return 0;
 }
@@ -17,6 +17,7 @@ void test_init_memory_pool(void) {
     assert(pool1->first->size == MIN_MEMORY_POOL_SIZE - sizeof(memory_block_t));
     assert(pool1->first->active == 0);
     assert(pool1->first->next == NULL);
+    assert(pool1->first->prev == NULL);
 
     // initialize memory pool with 0 size
     pool2 = init_memory_pool(0);
@@ -101,6 +102,122 @@ void test_memory_alloc_free(void) {
     printf("test_memory_alloc_free passed\n");
 }
 
+void test_memory_size_classes(void) {
+    // the small sizes have one list each, the larger ones are split by the bits below the highest set bit
+    int size_class;
+    int subclass;
+    memory_size_class(15, &size_class, &subclass);
+    assert(size_class == 0 && subclass == 15);
+    memory_size_class(16, &size_class, &subclass);
+    assert(size_class == 1 && subclass == 0);
+    memory_size_class(1000, &size_class, &subclass);
+    assert(size_class == 6 && subclass == 15);
+    memory_size_class(1024, &size_class, &subclass);
+    assert(size_class == 7 && subclass == 0);
+
+    // pool1 holds a single free block again
+    void* small = memory_pool_alloc(pool1, 96);
+    void* separator = memory_pool_alloc(pool1, 96);
+    void* large = memory_pool_alloc(pool1, 4000);
+    void* guard = memory_pool_alloc(pool1, 96);
+    assert(small != NULL && separator != NULL && large != NULL && guard != NULL);
+
+    // a freed block is reused by a request of the same size class
+    memory_pool_free(pool1, large);
+    void* same_class = memory_pool_alloc(pool1, 3000);
+    assert(same_class == large);
+    memory_pool_free(pool1, same_class);
+
+    // a free block that is too small is skipped for a larger class
+    memory_pool_free(pool1, small);
+    void* larger = memory_pool_alloc(pool1, 192);
+    assert(larger == large);
+    memory_size_class(96, &size_class, &subclass);
+    assert(pool1->free_lists[size_class][subclass] == (memory_block_t*) small - 1);
+
+    // a second free of the same pointer is ignored
+    memory_pool_free(pool1, larger);
+    memory_pool_free(pool1, larger);
+    void* first = memory_pool_alloc(pool1, 4000);
+    void* second = memory_pool_alloc(pool1, 4000);
+    assert(first != second);
+    printf("Test: \"free blocks are found by size class\" passed\n");
+
+    memory_pool_free(pool1, first);
+    memory_pool_free(pool1, second);
+    memory_pool_free(pool1, guard);
+    memory_pool_free(pool1, separator);
+    assert(pool1->first->active == 0);
+    assert(pool1->first->next == NULL);
+
+    printf("test_memory_size_classes passed\n");
+}
+
+void test_memory_fit_without_larger_class(void) {
+    memory_pool_t* pool = init_memory_pool(MIN_MEMORY_POOL_SIZE);
+    assert(pool != NULL);
+    void* large = memory_pool_alloc(pool, 1016);
+    void* separator1 = memory_pool_alloc(pool, 16);
+    void* medium = memory_pool_alloc(pool, 600);
+    void* separator2 = memory_pool_alloc(pool, 16);
+    void* same_subclass = memory_pool_alloc(pool, 992);
+    void* separator3 = memory_pool_alloc(pool, 16);
+    assert(large != NULL && medium != NULL && same_subclass != NULL);
+    // use up the rest of the pool, so no larger free block is left
+    const memory_block_t* rest = ((memory_block_t*) separator3 - 1)->next;
+    void* filler = memory_pool_alloc(pool, rest->size);
+    assert(filler != NULL);
+
+    // both blocks share the size class, the smaller one is the head of its list
+    memory_pool_free(pool, large);
+    memory_pool_free(pool, medium);
+    void* fit = memory_pool_alloc(pool, 904);
+    assert(fit == large);
+
+    // the block that fits lies behind a smaller one of the same subclass
+    memory_pool_free(pool, fit);
+    memory_pool_free(pool, same_subclass);
+    fit = memory_pool_alloc(pool, 1000);
+    assert(fit == large);
+    assert(memory_pool_alloc(pool, 1200) == NULL);
+    printf("Test: \"a fitting block is found without a larger size class\" passed\n");
+
+    shutdown_memory_pool(pool);
+    printf("test_memory_fit_without_larger_class passed\n");
+}
+
+void test_memory_merge_neighbours(void) {
+    const size_t size = 512;
+    void* ptrs[4];
+    for (int i = 0; i < 4; i++) {
+        ptrs[i] = memory_pool_alloc(pool1, size);
+        assert(ptrs[i] != NULL);
+    }
+    memory_block_t* first = (memory_block_t*) ptrs[0] - 1;
+    memory_block_t* last = (memory_block_t*) ptrs[3] - 1;
+
+    // the freed block in the middle merges with the free blocks on both sides
+    memory_pool_free(pool1, ptrs[0]);
+    memory_pool_free(pool1, ptrs[2]);
+    memory_pool_free(pool1, ptrs[1]);
+    assert(first->active == 0);
+    assert(first->size == 3 * size + 2 * sizeof(memory_block_t));
+    assert(first->next == last);
+    assert(last->prev == first);
+
+    // the merged block is found in its new size class
+    void* merged = memory_pool_alloc(pool1, 3 * size);
+    assert(merged == ptrs[0]);
+    printf("Test: \"freed blocks merge with both neighbours\" passed\n");
+
+    memory_pool_free(pool1, merged);
+    memory_pool_free(pool1, ptrs[3]);
+    assert(pool1->first->active == 0);
+    assert(pool1->first->next == NULL);
+
+    printf("test_memory_merge_neighbours passed\n");
+}
+
 void tear_down(void) {
     shutdown_memory_pool(pool1);
     shutdown_memory_pool(pool2);
@@ -109,6 +226,9 @@ void tear_down(void) {
 int main(void) {
     test_init_memory_pool();
     test_memory_alloc_free();
+    test_memory_size_classes();
+    test_memory_fit_without_larger_class();
+    test_memory_merge_neighbours();
     tear_down();
     return 0;
 }
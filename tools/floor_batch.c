@@ -0,0 +1,329 @@
+/**
+ * @file floor_batch.c
+ * @brief Headless tool that generates and validates a batch of seeded floors on all cores.
+ *
+ * Usage: floor_batch <count> [first_seed] [width] [height] [threads] [layout]
+ *
+ * The layout is one of the names in layout_generators (maze, rooms, cave), maze by default.
+ * The count and the threads must be at least 1, all processors are used if no threads are given.
+ * Floor i is generated with derive_seed(first_seed, i). Every floor is checked for a reachable
+ * exit and key, for the expected number of fountains and for at most ENEMY_COUNT enemies (small
+ * floors get fewer enemies, their mean is reported). The aggregate statistics
+ * are written as JSON to stdout, every failed floor is reported on stderr with its seed.
+ */
+#include "../src/map/map.h"
+#include "../src/map/map_generator.h"
+#include "../src/random/rng.h"
+#include "../src/thread/thread_handler.h"
+
+#include <errno.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define FLOORS_PER_CLAIM 16// floors a worker takes at once from the shared counter
+#define MAX_WORKERS 1024
+
+typedef enum {
+    FLOOR_VALID,
+    FLOOR_GENERATION_FAILED,
+    FLOOR_EXIT_UNREACHABLE,
+    FLOOR_KEY_UNREACHABLE,
+    FLOOR_WRONG_KEY_COUNT,
+    FLOOR_WRONG_FOUNTAIN_COUNT,
+    FLOOR_WRONG_ENEMY_COUNT,
+    MAX_FLOOR_RESULTS
+} floor_result_t;
+
+const char* floor_result_names[] = {
+        "valid",
+        "generation_failed",
+        "exit_unreachable",
+        "key_unreachable",
+        "wrong_key_count",
+        "wrong_fountain_count",
+        "wrong_enemy_count",
+};
+
+typedef struct {
+    uint64_t floors;
+    uint64_t results[MAX_FLOOR_RESULTS];
+    uint64_t exit_distance_sum;// shortest path from the start to the exit, summed over the valid floors
+    int exit_distance_min;
+    int exit_distance_max;
+    uint64_t floor_cells;// walkable cells, summed over the valid floors
+    uint64_t enemies;    // enemies, summed over the valid floors
+} batch_stats_t;
+
+// the batch shared by all workers
+typedef struct {
+    int width;
+    int height;
+    floor_layout_t layout;
+    uint64_t count;
+    uint64_t first_seed;
+    atomic_uint_fast64_t next;// the index of the next floor to generate
+} batch_job_t;
+
+typedef struct {
+    batch_job_t* job;
+    batch_stats_t stats;// the statistics of this worker, merged after the join
+} batch_worker_arg_t;
+
+/**
+ * @brief Returns the current timestamp in nanoseconds.
+ */
+uint64_t batch_now_ns(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+/**
+ * @brief Breadth first search over all non-wall tiles, starting at the start position of the map.
+ *
+ * @param map the map to search
+ * @param distance receives the distance of every cell from the start, -1 if unreachable
+ * @param queue a buffer with one entry per cell
+ */
+void fill_distances(const map_t* map, int* distance, int* queue) {
+    const int cells = map->width * map->height;
+    for (int i = 0; i < cells; i++) {
+        distance[i] = -1;
+    }
+
+    int head = 0;
+    int tail = 0;
+    const int start = map->start.dy * map->width + map->start.dx;
+    distance[start] = 0;
+    queue[tail++] = start;
+    while (head < tail) {
+        const int cell = queue[head++];
+        const int x = cell % map->width;
+        const int y = cell / map->width;
+        for (int i = 0; i < 4; i++) {
+            const int nx = x + directions[i].dx;
+            const int ny = y + directions[i].dy;
+            if (nx < 0 || nx >= map->width || ny < 0 || ny >= map->height) continue;
+
+            const int next = ny * map->width + nx;
+            if (distance[next] != -1 || map->tiles[next] == WALL) continue;
+            distance[next] = distance[cell] + 1;
+            queue[tail++] = next;
+        }
+    }
+}
+
+/**
+ * @brief Checks a generated floor.
+ *
+ * @param map the floor to check
+ * @param distance a buffer with one entry per cell
+ * @param queue a buffer with one entry per cell
+ * @param stats the statistics to add a valid floor to
+ * @return the result of the check
+ */
+floor_result_t validate_floor(const map_t* map, int* distance, int* queue, batch_stats_t* stats) {
+    fill_distances(map, distance, queue);
+
+    int keys = 0, key_reachable = 0, fountains = 0, enemies = 0, floor_cells = 0;
+    const int cells = map->width * map->height;
+    for (int i = 0; i < cells; i++) {
+        switch (map->tiles[i]) {
+            case KEY:
+                keys++;
+                key_reachable = distance[i] != -1;
+                break;
+            case LIFE_FOUNTAIN:
+            case MANA_FOUNTAIN:
+                fountains++;
+                break;
+            case GOBLIN:
+                enemies++;
+                break;
+            default:
+                break;
+        }
+        floor_cells += map->tiles[i] != WALL;
+    }
+
+    const int exit_distance = distance[map->exit.dy * map->width + map->exit.dx];
+    if (exit_distance == -1) return FLOOR_EXIT_UNREACHABLE;
+    if (keys != 1) return FLOOR_WRONG_KEY_COUNT;
+    if (!key_reachable) return FLOOR_KEY_UNREACHABLE;
+    if (fountains != 2) return FLOOR_WRONG_FOUNTAIN_COUNT;
+    if (enemies > ENEMY_COUNT) return FLOOR_WRONG_ENEMY_COUNT;
+
+    stats->exit_distance_sum += (uint64_t) exit_distance;
+    if (exit_distance < stats->exit_distance_min) stats->exit_distance_min = exit_distance;
+    if (exit_distance > stats->exit_distance_max) stats->exit_distance_max = exit_distance;
+    stats->floor_cells += (uint64_t) floor_cells;
+    stats->enemies += (uint64_t) enemies;
+    return FLOOR_VALID;
+}
+
+/**
+ * @brief Generates and checks floors until the job is done.
+ *
+ * @param arg the batch_worker_arg_t of this worker
+ */
+void batch_worker(void* arg) {
+    batch_worker_arg_t* worker = arg;
+    batch_job_t* job = worker->job;
+
+    map_t* map = init_map(job->width, job->height);
+    int* distance = malloc((size_t) job->width * job->height * sizeof(int));
+    int* queue = malloc((size_t) job->width * job->height * sizeof(int));
+    if (map == NULL || distance == NULL || queue == NULL) {
+        fprintf(stderr, "A worker failed to allocate its buffers\n");
+        free_map(map);
+        free(distance);
+        free(queue);
+        return;
+    }
+
+    for (;;) {
+        const uint64_t first = atomic_fetch_add(&job->next, FLOORS_PER_CLAIM);
+        if (first >= job->count) break;
+        const uint64_t last = first + FLOORS_PER_CLAIM < job->count ? first + FLOORS_PER_CLAIM : job->count;
+
+        for (uint64_t i = first; i < last; i++) {
+            const uint64_t seed = derive_seed(job->first_seed, i);
+            floor_result_t result = FLOOR_GENERATION_FAILED;
+            if (generate_map(map, NULL, seed, job->layout) == COMMON_SUCCESS) {
+                result = validate_floor(map, distance, queue, &worker->stats);
+            }
+            worker->stats.floors++;
+            worker->stats.results[result]++;
+            if (result != FLOOR_VALID) {
+                fprintf(stderr, "Floor %llu (seed %llu) is invalid: %s\n", (unsigned long long) i,
+                        (unsigned long long) seed, floor_result_names[result]);
+            }
+        }
+    }
+
+    free_map(map);
+    free(distance);
+    free(queue);
+}
+
+/**
+ * @brief Parses a decimal command line argument.
+ *
+ * @param text the argument
+ * @param min the smallest valid value
+ * @param max the largest valid value
+ * @param value receives the parsed value
+ * @return 0 on success, 1 if the argument is not a number or out of range
+ */
+int parse_argument(const char* text, const unsigned long long min, const unsigned long long max, unsigned long long* value) {
+    // strtoull accepts a sign and wraps negative numbers around
+    if (text[0] < '0' || text[0] > '9') return 1;
+    char* end;
+    errno = 0;
+    *value = strtoull(text, &end, 10);
+    return errno != 0 || *end != '\0' || *value < min || *value > max;
+}
+
+int main(const int argc, char* argv[]) {
+    const char* usage = "Usage: %s <count> [first_seed] [width] [height] [threads] [layout]\n"
+                        "count and threads must be at least 1, threads at most %d\n";
+    unsigned long long count = 0;
+    unsigned long long first_seed = 1;
+    unsigned long long width = DEFAULT_MAP_WIDTH;
+    unsigned long long height = DEFAULT_MAP_HEIGHT;
+    unsigned long long threads_arg = 0;
+    if (argc < 2 || parse_argument(argv[1], 1, UINT64_MAX, &count) ||
+        (argc > 2 && parse_argument(argv[2], 0, UINT64_MAX, &first_seed)) ||
+        (argc > 3 && parse_argument(argv[3], 0, MAX_MAP_WIDTH, &width)) ||
+        (argc > 4 && parse_argument(argv[4], 0, MAX_MAP_HEIGHT, &height)) ||
+        (argc > 5 && parse_argument(argv[5], 1, MAX_WORKERS, &threads_arg))) {
+        fprintf(stderr, usage, argv[0], MAX_WORKERS);
+        return 1;
+    }
+    batch_job_t job;
+    job.count = count;
+    job.first_seed = first_seed;
+    job.width = (int) width;
+    job.height = (int) height;
+    atomic_init(&job.next, 0);
+    int thread_count = argc > 5 ? (int) threads_arg : get_processor_count();
+    if (thread_count > MAX_WORKERS) thread_count = MAX_WORKERS;
+    job.layout = MAX_LAYOUTS;
+    for (int i = 0; i < MAX_LAYOUTS; i++) {
+        if (argc <= 6 || strcmp(argv[6], layout_generators[i].name) == 0) {
+            job.layout = (floor_layout_t) i;
+            break;
+        }
+    }
+    if (job.layout == MAX_LAYOUTS) {
+        fprintf(stderr, "Unknown layout %s\n", argv[6]);
+        return 1;
+    }
+
+    if (job.width < MIN_MAP_WIDTH || job.width > MAX_MAP_WIDTH || job.height < MIN_MAP_HEIGHT ||
+        job.height > MAX_MAP_HEIGHT || job.width % 2 == 0 || job.height % 2 == 0) {
+        fprintf(stderr, "Invalid floor size %d x %d, both must be odd and between %d and %d\n", job.width, job.height,
+                MIN_MAP_WIDTH, MAX_MAP_WIDTH);
+        return 1;
+    }
+
+    batch_worker_arg_t* workers = calloc((size_t) thread_count, sizeof(batch_worker_arg_t));
+    thread_handle_t* threads = calloc((size_t) thread_count, sizeof(thread_handle_t));
+    if (workers == NULL || threads == NULL) {
+        fprintf(stderr, "Failed to allocate the workers\n");
+        free(workers);
+        free(threads);
+        return 1;
+    }
+
+    const uint64_t start = batch_now_ns();
+    for (int i = 0; i < thread_count; i++) {
+        workers[i].job = &job;
+        workers[i].stats.exit_distance_min = job.width * job.height;
+        threads[i] = start_thread(batch_worker, &workers[i]);
+        if (threads[i] == NULL) {
+            fprintf(stderr, "Failed to start worker %d, continuing with fewer workers\n", i);
+        }
+    }
+
+    batch_stats_t total = {0};
+    total.exit_distance_min = job.width * job.height;
+    for (int i = 0; i < thread_count; i++) {
+        join_thread(threads[i]);
+        const batch_stats_t* stats = &workers[i].stats;
+        total.floors += stats->floors;
+        for (int r = 0; r < MAX_FLOOR_RESULTS; r++) {
+            total.results[r] += stats->results[r];
+        }
+        total.exit_distance_sum += stats->exit_distance_sum;
+        total.floor_cells += stats->floor_cells;
+        total.enemies += stats->enemies;
+        if (stats->exit_distance_min < total.exit_distance_min) total.exit_distance_min = stats->exit_distance_min;
+        if (stats->exit_distance_max > total.exit_distance_max) total.exit_distance_max = stats->exit_distance_max;
+    }
+    const double seconds = (double) (batch_now_ns() - start) / 1e9;
+
+    const uint64_t valid = total.results[FLOOR_VALID];
+    printf("{\n  \"layout\": \"%s\",\n  \"width\": %d,\n  \"height\": %d,\n  \"first_seed\": %llu,\n  \"threads\": %d,\n",
+           layout_generators[job.layout].name, job.width, job.height,
+           (unsigned long long) job.first_seed, thread_count);
+    printf("  \"floors\": %llu,\n  \"seconds\": %.3f,\n  \"floors_per_sec\": %.2f,\n", (unsigned long long) total.floors,
+           seconds, seconds > 0 ? total.floors / seconds : 0.0);
+    printf("  \"results\": {");
+    for (int r = 0; r < MAX_FLOOR_RESULTS; r++) {
+        printf("%s\"%s\": %llu", r > 0 ? ", " : "", floor_result_names[r], (unsigned long long) total.results[r]);
+    }
+    printf("},\n");
+    printf("  \"exit_distance\": {\"min\": %d, \"max\": %d, \"mean\": %.2f},\n", valid > 0 ? total.exit_distance_min : 0,
+           total.exit_distance_max, valid > 0 ? (double) total.exit_distance_sum / valid : 0.0);
+    printf("  \"mean_floor_cells\": %.2f,\n", valid > 0 ? (double) total.floor_cells / valid : 0.0);
+    printf("  \"mean_enemies\": %.2f\n}\n", valid > 0 ? (double) total.enemies / valid : 0.0);
+
+    free(workers);
+    free(threads);
+    return total.floors == job.count && valid == job.count ? 0 : 1;
+}
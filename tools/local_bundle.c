@@ -0,0 +1,402 @@
+/**
+ * @file local_bundle.c
+ * @brief Build tool that compiles the properties files of all languages into a generated C table of texts.
+ *
+ * Usage: local_bundle <keys_header> <bundle_source> <properties_file>...
+ *
+ * The properties files are given in the order of local_lang_t. The keys of the first file define the
+ * key ids (local_key_t, in the order of the file) and every other language must have exactly the
+ * same keys, otherwise the build fails. The keys are indexed by a minimal perfect hash, so a string
+ * key is resolved with a single key comparison.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_LANGUAGES 16
+#define MAX_SEED_TRIES 100000000u
+#define KEYS_PER_BUCKET 4// the average number of keys per bucket of the perfect hash
+
+/**
+ * @brief The keys and texts of one properties file, in the order of the file.
+ */
+typedef struct {
+    const char* path;
+    char* content;// the file, keys and texts are terminated in place
+    char** keys;
+    char** texts;
+    int count;
+} properties_t;
+
+/**
+ * @brief The hash of the perfect hash, the generated lookup contains the same function (see write_bundle).
+ * @param key the key
+ * @param seed 0 for the bucket, the seed of the bucket for the slot
+ * @return the hash
+ */
+uint32_t hash_key(const char* key, const uint32_t seed) {
+    uint32_t hash = 2166136261u ^ (seed * 0x9e3779b9u);
+    for (const unsigned char* c = (const unsigned char*) key; *c != '\0'; c++) {
+        hash = (hash ^ *c) * 16777619u;
+    }
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    return hash;
+}
+
+/**
+ * @brief Reads a properties file, every line of the form KEY="text" is a key, '#' starts a comment.
+ * @param props the properties to fill
+ * @param path the path of the file
+ * @return 0 on success, 1 on failure
+ */
+int read_properties(properties_t* props, const char* path) {
+    props->path = path;
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        fprintf(stderr, "%s: cannot open the file\n", path);
+        return 1;
+    }
+    fseek(file, 0, SEEK_END);
+    const long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    props->content = malloc((size_t) size + 1);
+    // every key takes at least one line
+    props->keys = malloc(((size_t) size / 2 + 1) * sizeof(char*));
+    props->texts = malloc(((size_t) size / 2 + 1) * sizeof(char*));
+    if (size < 0 || props->content == NULL || props->keys == NULL || props->texts == NULL ||
+        fread(props->content, 1, (size_t) size, file) != (size_t) size) {
+        fprintf(stderr, "%s: cannot read the file\n", path);
+        fclose(file);
+        return 1;
+    }
+    fclose(file);
+    props->content[size] = '\0';
+    props->count = 0;
+
+    int line_number = 0;
+    char* line = props->content;
+    while (line < props->content + size) {
+        char* line_end = strchr(line, '\n');
+        if (line_end == NULL) line_end = props->content + size;
+        *line_end = '\0';
+        if (line_end > line && line_end[-1] == '\r') line_end[-1] = '\0';
+        line_number++;
+
+        if (line[0] != '\0' && line[0] != '#') {
+            char* equals = strchr(line, '=');
+            char* start = equals != NULL ? strchr(equals, '"') : NULL;
+            char* end = start != NULL ? strchr(start + 1, '"') : NULL;
+            if (equals == line || end == NULL) {
+                fprintf(stderr, "%s:%d: expected KEY=\"text\"\n", path, line_number);
+                return 1;
+            }
+            for (const char* c = line; c < equals; c++) {
+                if (!((*c >= 'A' && *c <= 'Z') || (*c >= '0' && *c <= '9') || *c == '_' || *c == '.')) {
+                    fprintf(stderr, "%s:%d: a key may only contain A-Z, 0-9, '_' and '.'\n", path, line_number);
+                    return 1;
+                }
+            }
+            *equals = '\0';
+            *end = '\0';
+            for (int i = 0; i < props->count; i++) {
+                if (strcmp(props->keys[i], line) == 0) {
+                    fprintf(stderr, "%s:%d: duplicate key %s\n", path, line_number, line);
+                    return 1;
+                }
+            }
+            props->keys[props->count] = line;
+            props->texts[props->count] = start + 1;
+            props->count++;
+        }
+        line = line_end + 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Finds a key in the properties.
+ * @return the index of the key, -1 if the key is missing
+ */
+int find_key(const properties_t* props, const char* key) {
+    for (int i = 0; i < props->count; i++) {
+        if (strcmp(props->keys[i], key) == 0) return i;
+    }
+    return -1;
+}
+
+/**
+ * @brief Checks that every language has exactly the keys of the first language.
+ * @return 0 if the keys match, 1 otherwise
+ */
+int check_keys(const properties_t* langs, const int lang_count) {
+    int result = 0;
+    for (int lang = 1; lang < lang_count; lang++) {
+        for (int i = 0; i < langs[0].count; i++) {
+            if (find_key(&langs[lang], langs[0].keys[i]) < 0) {
+                fprintf(stderr, "%s: missing key %s\n", langs[lang].path, langs[0].keys[i]);
+                result = 1;
+            }
+        }
+        for (int i = 0; i < langs[lang].count; i++) {
+            if (find_key(&langs[0], langs[lang].keys[i]) < 0) {
+                fprintf(stderr, "%s: key %s is missing in %s\n", langs[lang].path, langs[lang].keys[i], langs[0].path);
+                result = 1;
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Builds a minimal perfect hash (hash and displace) over the keys.
+ *
+ * Every key falls into the bucket hash_key(key, 0) % bucket_count. The buckets are placed from the
+ * largest to the smallest, each with the first seed that moves all its keys to free slots
+ * hash_key(key, seed) % key_count.
+ *
+ * @param keys the keys
+ * @param key_count the number of keys, also the number of slots
+ * @param bucket_count the number of buckets
+ * @param seeds the seed of every bucket
+ * @param ids the key of every slot
+ * @return 0 on success, 1 if no seed was found for a bucket
+ */
+int build_perfect_hash(char** keys, const int key_count, const int bucket_count, uint32_t* seeds, int* ids) {
+    int* bucket_of = malloc((size_t) key_count * sizeof(int));
+    int* order = malloc((size_t) bucket_count * sizeof(int));
+    int* sizes = calloc((size_t) bucket_count, sizeof(int));
+    int* slots = malloc(KEYS_PER_BUCKET * 8 * sizeof(int));
+    if (bucket_of == NULL || order == NULL || sizes == NULL || slots == NULL) return 1;
+
+    for (int i = 0; i < key_count; i++) {
+        bucket_of[i] = (int) (hash_key(keys[i], 0) % (uint32_t) bucket_count);
+        sizes[bucket_of[i]]++;
+    }
+    for (int i = 0; i < bucket_count; i++) {
+        order[i] = i;
+    }
+    // insertion sort, the largest bucket first
+    for (int i = 1; i < bucket_count; i++) {
+        const int bucket = order[i];
+        int j = i;
+        while (j > 0 && sizes[order[j - 1]] < sizes[bucket]) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = bucket;
+    }
+    for (int i = 0; i < key_count; i++) {
+        ids[i] = -1;
+    }
+
+    int result = 0;
+    for (int i = 0; i < bucket_count && result == 0; i++) {
+        const int bucket = order[i];
+        seeds[bucket] = 0;
+        if (sizes[bucket] == 0) continue;
+        if (sizes[bucket] > KEYS_PER_BUCKET * 8) {
+            fprintf(stderr, "too many keys in one bucket of the perfect hash\n");
+            result = 1;
+            break;
+        }
+        uint32_t seed = 1;
+        for (; seed < MAX_SEED_TRIES; seed++) {
+            int placed = 0;
+            int fits = 1;
+            for (int key = 0; key < key_count && fits; key++) {
+                if (bucket_of[key] != bucket) continue;
+                const int slot = (int) (hash_key(keys[key], seed) % (uint32_t) key_count);
+                fits = ids[slot] < 0;
+                for (int j = 0; j < placed && fits; j++) {
+                    fits = slots[j] != slot;
+                }
+                slots[placed++] = slot;
+            }
+            if (fits) break;
+        }
+        if (seed == MAX_SEED_TRIES) {
+            fprintf(stderr, "no seed found for a bucket of the perfect hash\n");
+            result = 1;
+            break;
+        }
+        seeds[bucket] = seed;
+        for (int key = 0; key < key_count; key++) {
+            if (bucket_of[key] == bucket) ids[hash_key(keys[key], seed) % (uint32_t) key_count] = key;
+        }
+    }
+    free(slots);
+    free(sizes);
+    free(order);
+    free(bucket_of);
+    return result;
+}
+
+/**
+ * @brief Writes a text as a C string literal, everything except printable ASCII is escaped.
+ */
+void write_literal(FILE* out, const char* text) {
+    fputc('"', out);
+    for (const unsigned char* c = (const unsigned char*) text; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') {
+            fprintf(out, "\\%c", *c);
+        } else if (*c < 0x20 || *c >= 0x7f) {
+            // always three digits, so a following digit is not taken into the escape
+            fprintf(out, "\\%03o", *c);
+        } else {
+            fputc(*c, out);
+        }
+    }
+    fputc('"', out);
+}
+
+/**
+ * @brief Writes the enum name of a key, e.g. LOCAL_MAP_TITLE for MAP.TITLE.
+ */
+void write_key_id(FILE* out, const char* key) {
+    fputs("LOCAL_", out);
+    for (const char* c = key; *c != '\0'; c++) {
+        fputc(*c == '.' ? '_' : *c, out);
+    }
+}
+
+/**
+ * @brief Writes the header with the key ids and the declarations of the tables.
+ * @return 0 on success, 1 if two keys have the same id
+ */
+int write_keys_header(const char* path, const properties_t* first, const int lang_count, const int bucket_count) {
+    for (int i = 0; i < first->count; i++) {
+        for (int j = 0; j < i; j++) {
+            int same = strlen(first->keys[i]) == strlen(first->keys[j]);
+            for (size_t c = 0; same && first->keys[i][c] != '\0'; c++) {
+                same = (first->keys[i][c] == '.' ? '_' : first->keys[i][c]) == (first->keys[j][c] == '.' ? '_' : first->keys[j][c]);
+            }
+            if (same) {
+                fprintf(stderr, "%s: the keys %s and %s have the same id\n", first->path, first->keys[j], first->keys[i]);
+                return 1;
+            }
+        }
+    }
+
+    FILE* out = fopen(path, "w");
+    if (out == NULL) {
+        fprintf(stderr, "%s: cannot write the file\n", path);
+        return 1;
+    }
+    fprintf(out, "/**\n * @file local_keys.h\n * @brief The ids of the localized texts, generated by tools/local_bundle.c. Do not edit.\n */\n");
+    fprintf(out, "#ifndef LOCAL_KEYS_H\n#define LOCAL_KEYS_H\n\n#include <stdint.h>\n\n");
+    fprintf(out, "#define LOCAL_LANG_COUNT %d\n#define LOCAL_HASH_BUCKETS %d\n\n", lang_count, bucket_count);
+    fprintf(out, "typedef enum {\n");
+    for (int i = 0; i < first->count; i++) {
+        fputs("    ", out);
+        write_key_id(out, first->keys[i]);
+        fputs(",\n", out);
+    }
+    fprintf(out, "    LOCAL_KEY_COUNT\n} local_key_t;\n\n");
+    fprintf(out, "// the texts of every language, indexed by local_key_t\n");
+    fprintf(out, "extern const char* const local_bundles[LOCAL_LANG_COUNT][LOCAL_KEY_COUNT];\n\n");
+    fprintf(out, "/**\n * @brief Finds the id of a key with the perfect hash.\n * @param key the key, e.g. \"MAP.TITLE\"\n");
+    fprintf(out, " * @return the id of the key, LOCAL_KEY_COUNT if there is no such key\n */\n");
+    fprintf(out, "local_key_t find_local_key(const char* key);\n\n#endif//LOCAL_KEYS_H\n");
+    return fclose(out) != 0;
+}
+
+/**
+ * @brief Writes the source with the texts of all languages and the perfect hash.
+ * @return 0 on success, 1 on failure
+ */
+int write_bundle(const char* path, const properties_t* langs, const int lang_count, const int bucket_count, const uint32_t* seeds,
+                 const int* ids) {
+    FILE* out = fopen(path, "w");
+    if (out == NULL) {
+        fprintf(stderr, "%s: cannot write the file\n", path);
+        return 1;
+    }
+    const properties_t* first = &langs[0];
+    fprintf(out, "/**\n * @file local_bundle.c\n * @brief The localized texts, generated by tools/local_bundle.c. Do not edit.\n */\n");
+    fprintf(out, "#include \"local_keys.h\"\n\n#include <string.h>\n\n");
+
+    fprintf(out, "const char* const local_bundles[LOCAL_LANG_COUNT][LOCAL_KEY_COUNT] = {\n");
+    for (int lang = 0; lang < lang_count; lang++) {
+        fprintf(out, "    {// %s\n", langs[lang].path);
+        for (int i = 0; i < first->count; i++) {
+            fputs("        [", out);
+            write_key_id(out, first->keys[i]);
+            fputs("] = ", out);
+            write_literal(out, langs[lang].texts[find_key(&langs[lang], first->keys[i])]);
+            fputs(",\n", out);
+        }
+        fputs("    },\n", out);
+    }
+    fputs("};\n\n", out);
+
+    fputs("static const char* const local_key_names[LOCAL_KEY_COUNT] = {\n", out);
+    for (int i = 0; i < first->count; i++) {
+        fputs("    ", out);
+        write_literal(out, first->keys[i]);
+        fputs(",\n", out);
+    }
+    fputs("};\n\n", out);
+
+    fputs("static const uint32_t local_hash_seeds[LOCAL_HASH_BUCKETS] = {", out);
+    for (int i = 0; i < bucket_count; i++) {
+        fprintf(out, "%s%u", i % 12 == 0 ? "\n    " : " ", seeds[i]);
+        if (i + 1 < bucket_count) fputc(',', out);
+    }
+    fputs("\n};\n\n", out);
+
+    fputs("static const uint16_t local_hash_ids[LOCAL_KEY_COUNT] = {", out);
+    for (int i = 0; i < first->count; i++) {
+        fprintf(out, "%s%d", i % 16 == 0 ? "\n    " : " ", ids[i]);
+        if (i + 1 < first->count) fputc(',', out);
+    }
+    fputs("\n};\n\n", out);
+
+    // the same function as hash_key of the tool
+    fputs("static uint32_t hash_local_key(const char* key, const uint32_t seed) {\n"
+          "    uint32_t hash = 2166136261u ^ (seed * 0x9e3779b9u);\n"
+          "    for (const unsigned char* c = (const unsigned char*) key; *c != '\\0'; c++) {\n"
+          "        hash = (hash ^ *c) * 16777619u;\n"
+          "    }\n"
+          "    hash ^= hash >> 16;\n"
+          "    hash *= 0x85ebca6bu;\n"
+          "    hash ^= hash >> 13;\n"
+          "    return hash;\n"
+          "}\n\n",
+          out);
+    fputs("local_key_t find_local_key(const char* key) {\n"
+          "    const uint32_t seed = local_hash_seeds[hash_local_key(key, 0) % LOCAL_HASH_BUCKETS];\n"
+          "    const local_key_t id = (local_key_t) local_hash_ids[hash_local_key(key, seed) % LOCAL_KEY_COUNT];\n"
+          "    return strcmp(local_key_names[id], key) == 0 ? id : LOCAL_KEY_COUNT;\n"
+          "}\n",
+          out);
+    return fclose(out) != 0;
+}
+
+int main(const int argc, char* argv[]) {
+    if (argc < 4 || argc - 3 > MAX_LANGUAGES) {
+        fprintf(stderr, "Usage: local_bundle <keys_header> <bundle_source> <properties_file>...\n");
+        return 1;
+    }
+    const int lang_count = argc - 3;
+    properties_t langs[MAX_LANGUAGES];
+    for (int lang = 0; lang < lang_count; lang++) {
+        if (read_properties(&langs[lang], argv[3 + lang]) != 0) return 1;
+    }
+    if (langs[0].count == 0 || langs[0].count > UINT16_MAX) {
+        fprintf(stderr, "%s: expected 1 to %d keys\n", langs[0].path, UINT16_MAX);
+        return 1;
+    }
+    if (check_keys(langs, lang_count) != 0) return 1;
+
+    const int bucket_count = (langs[0].count + KEYS_PER_BUCKET - 1) / KEYS_PER_BUCKET;
+    uint32_t* seeds = malloc((size_t) bucket_count * sizeof(uint32_t));
+    int* ids = malloc((size_t) langs[0].count * sizeof(int));
+    if (seeds == NULL || ids == NULL || build_perfect_hash(langs[0].keys, langs[0].count, bucket_count, seeds, ids) != 0) {
+        return 1;
+    }
+    if (write_keys_header(argv[1], &langs[0], lang_count, bucket_count) != 0) return 1;
+    return write_bundle(argv[2], langs, lang_count, bucket_count, seeds, ids);
+}